@@ -8,24 +8,19 @@
 
 namespace Iaonnis
 {
+	//Frames skipped by the zero-allocation test while caches, pools and the frame allocator grow to their working size.
+#define IAONNIS_ZERO_ALLOC_WARMUP_FRAMES 60
+
+	//Scene systems always step by this much, so a replayed frame simulates the same as the recorded one however long it takes.
+#define IAONNIS_SIMULATION_DT 0.2f
 
 	GLuint CreateShaderProgram(const char* vertexPath, const char* fragmentPath)
 	{
-		// Helper to read file contents
-		auto readFile = [](const char* path) -> std::string {
-			std::ifstream file(path, std::ios::in | std::ios::binary);
-			if (!file) return "";
-			std::string contents;
-			file.seekg(0, std::ios::end);
-			contents.resize(static_cast<size_t>(file.tellg()));
-			file.seekg(0, std::ios::beg);
-			file.read(&contents[0], contents.size());
-			file.close();
-			return contents;
-			};
+		// Read both stages in one batch
+		std::vector<IOResult> sources = IOService::ReadFiles({ vertexPath, fragmentPath });
 
-		std::string vertexCode = readFile(vertexPath);
-		std::string fragmentCode = readFile(fragmentPath);
+		std::string vertexCode(sources[0].buffer.begin(), sources[0].buffer.end());
+		std::string fragmentCode(sources[1].buffer.begin(), sources[1].buffer.end());
 
 		if (vertexCode.empty() || fragmentCode.empty())
 			return 0;
@@ -94,20 +89,28 @@ namespace Iaonnis
 
 	void Iaonnis::Application::InitializeApplication()
 	{
+		Log::Initialize();
+
 		if (glfwInit() != GLFW_TRUE)
 			return;
 
+		//Automated runs set this to the number of steady-state frames that must not allocate inside
+		//the IAONNIS_ASSERT_NO_ALLOCATIONS scopes. The application runs with a hidden window and exits once they are checked.
+		const char* zeroAllocationTest = std::getenv("IAONNIS_ZERO_ALLOC_TEST");
+
 		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
 		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
 		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 		glfwWindowHint(GLFW_SAMPLES, 4);
 		glfwWindowHint(GLFW_DECORATED, GLFW_TRUE);
+		glfwWindowHint(GLFW_VISIBLE, zeroAllocationTest ? GLFW_FALSE : GLFW_TRUE);
 
+		//Test machines may run without a monitor attached.
 		auto monitor = glfwGetPrimaryMonitor();
-		auto viewMode = glfwGetVideoMode(monitor);
+		auto viewMode = monitor ? glfwGetVideoMode(monitor) : nullptr;
 
-		windowWidth = viewMode->width;
-		windowHeight = viewMode->height;
+		windowWidth = viewMode ? viewMode->width : 1280;
+		windowHeight = viewMode ? viewMode->height : 720;
 
 		window = glfwCreateWindow(windowWidth, windowHeight, "Engine", nullptr, nullptr);
 
@@ -121,7 +124,7 @@ namespace Iaonnis
 		glfwMakeContextCurrent(window);
 
 #ifdef NDEBUG
-		glfwSwapInterval(1);
+		glfwSwapInterval(zeroAllocationTest ? 0 : 1);
 #else
 		glfwSwapInterval(0);
 #endif
@@ -134,6 +137,8 @@ namespace Iaonnis
 			IAONNIS_LOG_ERROR("Failed to initialize GLEW. Error: %s\n", errorString.c_str());
 		}
 
+		GPUCommandQueue::Initialize();
+
 		const auto& bytes = glewGetString(GLEW_VERSION);
 		std::string glewVersion = std::string((const char*)&bytes);
 		IAONNIS_LOG_INFO("Using GLEW: %s", glewVersion.c_str());
@@ -149,10 +154,28 @@ namespace Iaonnis
 		glfwSetMouseButtonCallback(window, mouse_button_callback);
 		glfwSetScrollCallback(window, scroll_callback);
 
-		EventBus::subscribe(EventType::MOUSE_CLICKED_EVENT, std::bind(&Application::onMouseClickDispatch, this, std::placeholders::_1));
-		EventBus::subscribe(EventType::MOUSE_MOVE_EVENT, std::bind(&Application::onMouseMoveDispatch, this, std::placeholders::_1));
-		EventBus::subscribe(EventType::KEY_PRESS_EVENT, std::bind(&Application::onKeyPressedEvent, this, std::placeholders::_1));
-		EventBus::subscribe(EventType::MOUSE_SCROLLED_EVENT, std::bind(&Application::onMouseScrollDispatch, this, std::placeholders::_1));
+		EventBus::subscribe<MouseClickedEvent, &Application::onMouseClickDispatch>(this);
+		EventBus::subscribe<MouseMoveEvent, &Application::onMouseMoveDispatch>(this);
+		EventBus::subscribe<KeyPressEvent, &Application::onKeyPressedEvent>(this);
+		EventBus::subscribe<MouseScrollEvent, &Application::onMouseScrollDispatch>(this);
+		EventBus::subscribe<ExitAppEvent, &Application::closeApp>(this);
+
+		//Input and resizes are posted as they arrive and drained once at the start of the next frame.
+		EventQueue::setCoalescing<FrameResizeEvent>(EventCoalescing::Replace);
+		EventQueue::setCoalescing<MouseMoveEvent>([](MouseMoveEvent& pending, const MouseMoveEvent& incoming)
+			{
+				pending.delta += incoming.position - pending.position;
+				pending.position = incoming.position;
+			});
+		EventQueue::setCoalescing<MouseScrollEvent>([](MouseScrollEvent& pending, const MouseScrollEvent& incoming)
+			{
+				pending.offset += incoming.offset;
+			});
+
+		IAONNIS_PROFILE_THREAD("Main");
+		JobSystem::Initialize();
+		IOService::Initialize();
+		FrameAllocator::Initialize();
 
 		program = CreateShaderProgram("Assets/Shaders/vertex.glsl", "Assets/Shaders/fragment.glsl");
 		glUseProgram(program);
@@ -161,6 +184,29 @@ namespace Iaonnis
 		editor = std::make_shared<Editor>(window, scene);
 
 		Iaonnis::Renderer3D::Initialize(program);
+		BuildFrameGraph();
+		RegisterFrameStats();
+
+		if (zeroAllocationTest)
+		{
+			zeroAllocationFramesLeft = (uint32_t)std::strtoul(zeroAllocationTest, nullptr, 10);
+#if !IAONNIS_MEMORY_TRACKING
+			IAONNIS_LOG_ERROR("The zero allocation test needs a build with IAONNIS_MEMORY_TRACKING.");
+			zeroAllocationFramesLeft = 0;
+			exitCode = 1;
+			glfwSetWindowShouldClose(window, GL_TRUE);
+#endif
+		}
+
+		if (const char* uuidBenchmark = std::getenv("IAONNIS_UUID_BENCHMARK"))
+			UUIDFactory::RunBenchmark((uint32_t)std::strtoul(uuidBenchmark, nullptr, 10));
+
+		//Benchmark runs record the input of a session once and replay it on every build they compare.
+		//A replay ignores live input and closes the application after its last frame.
+		if (const char* recordPath = std::getenv("IAONNIS_INPUT_RECORD"))
+			InputRecorder::BeginRecording(recordPath);
+		else if (const char* replayPath = std::getenv("IAONNIS_INPUT_REPLAY"))
+			InputRecorder::BeginReplay(replayPath);
 
 		glEnable(GL_MULTISAMPLE);
 		glEnable(GL_DEPTH_TEST);
@@ -174,39 +220,220 @@ namespace Iaonnis
 		self = this;
 	}
 
-	void Iaonnis::Application::OnUpdate()
+	void Application::BuildFrameGraph()
 	{
-		while (!glfwWindowShouldClose(window))
-		{
-			//DISABLE_SCOPE_TIMER_PRINT
+		frameGraph.AddStage("TransformUpdate", TaskAffinity::Any, {}, { "Transforms" }, [this]()
 			{
-				SCOPE_TIMER("SCENE_ONUPDATE");
-				scene->OnUpdate(0.2f);
-			}
+				IAONNIS_MEMORY_TAG(MemoryTag::Scene);
+				scene->OnUpdate(IAONNIS_SIMULATION_DT);
+			});
+
+		frameGraph.AddStage("GPUSync", TaskAffinity::MainThread, {}, { "MappedBuffers" }, [this]()
+			{
+				IAONNIS_MEMORY_TAG(MemoryTag::Renderer);
+				Renderer3D::BeginFrame(scene.get());
+			});
+
+		frameGraph.AddStage("MaterialUpload", TaskAffinity::Any, { "Resources", "MappedBuffers" }, { "MaterialTable" }, [this]()
+			{
+				IAONNIS_MEMORY_TAG(MemoryTag::Renderer);
+				Renderer3D::PrepareMaterials(scene.get());
+			});
 
+		frameGraph.AddStage("DrawCommandBuild", TaskAffinity::Any, { "Resources", "Transforms", "MaterialTable", "MappedBuffers" }, { "DrawCommands" }, [this]()
 			{
-				SCOPE_TIMER("RENDER_ONLY");
+				IAONNIS_MEMORY_TAG(MemoryTag::Renderer);
+				Renderer3D::BuildDrawCommands(scene.get());
+			});
+
+		frameGraph.AddStage("LightExtraction", TaskAffinity::Any, { "Transforms", "Camera" }, { "LightData" }, [this]()
+			{
+				IAONNIS_MEMORY_TAG(MemoryTag::Renderer);
+				Renderer3D::ExtractLights(scene.get());
+			});
+
+		frameGraph.AddStage("Render", TaskAffinity::MainThread, { "DrawCommands", "MaterialTable", "LightData", "Camera" }, { "RenderOutput" }, [this]()
+			{
+				IAONNIS_MEMORY_TAG(MemoryTag::Renderer);
 				Renderer3D::RenderScene(scene.get(), program);
-			}
+			});
+
+		//The editor can modify anything in the scene so it is ordered after every other stage.
+		frameGraph.AddStage("EditorUI", TaskAffinity::MainThread, { "RenderOutput" }, { "Transforms", "Camera", "Resources" }, [this]()
+			{
+				IAONNIS_MEMORY_TAG(MemoryTag::Editor);
+				editor->OnUpdate(Renderer3D::GetRenderStats(), Renderer3D::GetRenderOutput(), frameGraph.GetLastReport());
+			});
+
+		frameGraph.Compile();
+	}
+
+	void Application::RegisterFrameStats()
+	{
+		frameStatChannels.frameTime = FrameStats::RegisterChannel("Frame (ms)");
+
+		const TaskGraphReport& report = frameGraph.GetLastReport();
+		frameStatChannels.stages.clear();
+		for (const char* stageName : report.stageNames)
+			frameStatChannels.stages.push_back(FrameStats::RegisterChannel(std::string("CPU ") + stageName + " (ms)"));
+
+		for (int i = 0; i < (int)Renderer3D::RenderPass::Count; i++)
+			frameStatChannels.passes[i] = FrameStats::RegisterChannel(std::string("GPU ") + Renderer3D::GetRenderPassName((Renderer3D::RenderPass)i) + " (ms)");
+
+		frameStatChannels.drawCalls = FrameStats::RegisterChannel("Draw Calls");
+		frameStatChannels.vertices = FrameStats::RegisterChannel("Vertices");
+
+		//Automated runs set this to get one CSV row per frame.
+		if (const char* csvPath = std::getenv("IAONNIS_FRAME_STATS_CSV"))
+			FrameStats::OpenCSV(csvPath);
+
+		//Hitch detection is opt-in, profiling sessions set a threshold here or from the editor.
+		if (const char* hitchThreshold = std::getenv("IAONNIS_HITCH_THRESHOLD_MS"))
+			Profiler::SetHitchDetection(std::atof(hitchThreshold));
 
-			//ENABLE_SCOPE_TIMER_PRINT
+		//Scene state at the time of a capture, a hitch dump alone does not say what the frame was drawing.
+		Profiler::SetMetadataProvider([this](std::vector<std::pair<std::string, std::string>>& metadata)
 			{
-				SCOPE_TIMER("EDITOR_UPDATE");
-				editor->OnUpdate(Renderer3D::GetRenderStats(), Renderer3D::GetRenderOutput());
+				Renderer3D::RendererStatistics stats = Renderer3D::GetRenderStats();
+				metadata.push_back({ "Scene", scene->getName() });
+				metadata.push_back({ "Entities", std::to_string(scene->GetEntityCount()) });
+				metadata.push_back({ "Draw Calls", std::to_string(stats.nDrawCalls) });
+				metadata.push_back({ "Vertices", std::to_string(stats.nRenderedVertices) });
+				metadata.push_back({ "Pending GPU Commands", std::to_string(GPUCommandQueue::GetPendingCount()) });
+
+				for (int i = 0; i < (int)Renderer3D::RenderPass::Count; i++)
+					metadata.push_back({ std::string("GPU ") + Renderer3D::GetRenderPassName((Renderer3D::RenderPass)i) + " (ms)", std::to_string(stats.passTimings[i].gpuMs) });
+
+				for (int i = 0; i < (int)MemoryTag::Count; i++)
+				{
+					MemoryTagStats memory = MemoryTracker::GetStats((MemoryTag)i);
+					metadata.push_back({ std::string("Memory ") + MemoryTracker::GetTagName((MemoryTag)i) + " (KB)", std::to_string(memory.liveBytes / 1024) });
+				}
+
+				FramePercentiles frameTime = FrameStats::GetPercentiles(frameStatChannels.frameTime, 120);
+				metadata.push_back({ "Frame p50 (ms)", std::to_string(frameTime.p50) });
+				metadata.push_back({ "Frame p99 (ms)", std::to_string(frameTime.p99) });
+			});
+	}
+
+	void Application::RecordFrameStats(double frameTimeMs)
+	{
+		FrameStats::Record(frameStatChannels.frameTime, frameTimeMs);
+
+		const TaskGraphReport& report = frameGraph.GetLastReport();
+		for (size_t i = 0; i < report.stages.size() && i < frameStatChannels.stages.size(); i++)
+			FrameStats::Record(frameStatChannels.stages[i], report.stages[i].durationMs);
+
+		Renderer3D::RendererStatistics stats = Renderer3D::GetRenderStats();
+		for (int i = 0; i < (int)Renderer3D::RenderPass::Count; i++)
+			FrameStats::Record(frameStatChannels.passes[i], stats.passTimings[i].gpuMs);
+
+		FrameStats::Record(frameStatChannels.drawCalls, (double)stats.nDrawCalls);
+		FrameStats::Record(frameStatChannels.vertices, (double)stats.nRenderedVertices);
+
+		FrameStats::EndFrame();
+	}
+
+	bool Application::IsSteadyStateFrame(uint64_t frame)const
+	{
+		//Edits made by the previous frame are uploaded by this one, which is expected to allocate.
+		return frame >= IAONNIS_ZERO_ALLOC_WARMUP_FRAMES && !scene->IsEntityRegisteryDirty() && !scene->IsMaterialsDirty();
+	}
+
+	void Application::ReportAllocationViolations()
+	{
+		AllocationViolation violation;
+		while (MemoryTracker::PopAllocationViolation(violation))
+		{
+			IAONNIS_LOG_ERROR("Heap allocation in a steady-state frame. (Scope = %s, Allocations = %lld, Bytes = %lld)",
+				violation.scope, (long long)violation.allocations, (long long)violation.bytes);
+			exitCode = 1;
+		}
+
+		if (exitCode != 0)
+		{
+			IAONNIS_LOG_ERROR("Zero allocation test failed.");
+			zeroAllocationFramesLeft = 0;
+			glfwSetWindowShouldClose(window, GL_TRUE);
+		}
+		else if (--zeroAllocationFramesLeft == 0)
+		{
+			IAONNIS_LOG_INFO("Zero allocation test passed.");
+			glfwSetWindowShouldClose(window, GL_TRUE);
+		}
+	}
+
+	void Iaonnis::Application::OnUpdate()
+	{
+		auto lastFrame = std::chrono::steady_clock::now();
+		uint64_t frame = 0;
+
+		while (!glfwWindowShouldClose(window))
+		{
+			bool checkAllocations = zeroAllocationFramesLeft > 0 && IsSteadyStateFrame(frame++);
+			MemoryTracker::ArmZeroAllocationCheck(checkAllocations);
+
+			{
+				IAONNIS_PROFILE_SCOPE("Frame");
+				Log::DispatchEvents();
+
+				//The viewport action decides what mouse input does, a replay restores the recorded one before its events.
+				uint32_t viewPortAction = (uint32_t)editor->GetViewPortAction();
+				if (!InputRecorder::BeginFrame(viewPortAction))
+				{
+					InputRecorder::EndReplay();
+					glfwSetWindowShouldClose(window, GL_TRUE);
+				}
+				editor->SetViewPortAction((ViewPortAction)viewPortAction);
+
+				EventQueue::Dispatch();
+				InputRecorder::ReplayFrameEvents();
+
+				//Nothing from the previous frame is alive anymore, so its transient memory can be handed out again.
+				FrameAllocator::Reset();
+				MemoryTracker::NewFrame();
+
+				//Async loads finish here rather than inside a stage, their continuations add entities to the scene.
+				Renderer3D::ExecuteGPUCommands();
+				frameGraph.Execute();
+
+				IAONNIS_PROFILE_SCOPE("SwapBuffers");
+				glfwSwapBuffers(window);
+				glfwPollEvents();
 			}
 
-			glfwSwapBuffers(window);
-			glfwPollEvents();
+			Profiler::EndFrame();
+
+			MemoryTracker::ArmZeroAllocationCheck(false);
+			if (checkAllocations)
+				ReportAllocationViolations();
+
+			auto now = std::chrono::steady_clock::now();
+			double frameTimeMs = std::chrono::duration<double, std::milli>(now - lastFrame).count();
+			RecordFrameStats(frameTimeMs);
+			InputRecorder::EndFrame(frameTimeMs);
+			lastFrame = now;
 		}
 	}
 
 
-	void Iaonnis::Application::Shutdown()
+	int Iaonnis::Application::Shutdown()
 	{
+		FrameStats::CloseCSV();
+		InputRecorder::EndRecording();
+		InputRecorder::EndReplay();
+		IOService::Shutdown();
+		JobSystem::Shutdown();
+		GPUCommandQueue::Shutdown();
+		FrameAllocator::Shutdown();
+
 		editor->ShutDown();
 		Iaonnis::Renderer3D::Shutdown();
 		glfwDestroyWindow(window);
 		glfwTerminate();
+
+		Log::Shutdown();
+		return exitCode;
 	}
 
 	void Application::window_resize_callback(GLFWwindow* window, int x, int y)
@@ -214,10 +441,9 @@ namespace Iaonnis
 
 	}
 
-	void Application::closeApp(Event& event)
+	void Application::closeApp(ExitAppEvent& exitEvent)
 	{
-		ExitAppEvent* exitEvent = (ExitAppEvent*)&event;
-		if (exitEvent->promptStatus & PROMPT_FLAG_YES)
+		if (exitEvent.promptStatus & PROMPT_FLAG_YES)
 			glfwSetWindowShouldClose(window, GL_TRUE);
 		else
 			glfwSetWindowShouldClose(window, GL_FALSE);
@@ -230,7 +456,6 @@ namespace Iaonnis
 			| PROMPT_FLAG_CANCEL | PROMPT_FLAG_MODAL | PROMPT_FLAG_TEXT_CENTERED;
 		closePrompt.responseEventType = EventType::EXIT_APP_EVENT;
 
-		EventBus::subscribe(EventType::EXIT_APP_EVENT, std::bind(&Application::closeApp, self, std::placeholders::_1));
 		EventBus::publish(closePrompt);
 
 		//glfwSetWindowShouldClose(window, GL_FALSE);
@@ -238,71 +463,59 @@ namespace Iaonnis
 
 	void Application::cursor_position_callback(GLFWwindow* window, double xpos, double ypos)
 	{
+		if (InputRecorder::IsReplaying())
+			return;
+
 		MouseMoveEvent event;
 		event.position = { (float)xpos,(float)ypos };
 		event.delta = event.position - self->inputState.lastMousePosition;
 
-		EventBus::publish(event);
+		EventQueue::post(event);
 	}
 
 	void Application::key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
 	{
+		if (key == GLFW_KEY_F9 && action == GLFW_PRESS)
+			Profiler::BeginCapture(Profiler::GetCaptureFrameCount());
+
+		if (InputRecorder::IsReplaying())
+			return;
+
 		KeyPressEvent event;
 		event.keyCode = key;
 		event.scanCode = scancode;
 		event.action = action;
 		event.mods = mods;
 
-
-		auto camera = self->scene->GetSceneCamera();
-		auto frustrum = camera->getFrustrum();
-
-		float cameraSpeed = 0.5f;
-		glm::vec3 direction = glm::normalize(frustrum.target - frustrum.position);
-		glm::vec3 right = glm::normalize(glm::cross(direction, frustrum.up));
-		glm::vec3 strafe = right * cameraSpeed;
-
-		if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-			camera->updatePosition(direction * cameraSpeed);
-		if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-			camera->updatePosition(-direction * cameraSpeed);
-		if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-		{
-			camera->setPosition(frustrum.position - strafe);
-			camera->setTarget(frustrum.target - strafe);
-		}
-		if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-		{
-			camera->setPosition(frustrum.position + strafe);
-			camera->setTarget(frustrum.target + strafe);
-		}
-
-		IAONNIS_LOG_INFO("Camera Location:: %d ,%d, %d", frustrum.position.x, frustrum.position.g, frustrum.position.z);
-
-		EventBus::publish(event);
+		EventQueue::post(event);
 	}
 
 	void Application::mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
 	{
+		if (InputRecorder::IsReplaying())
+			return;
+
 		MouseClickedEvent mouseEvent;
 		mouseEvent.button = button;
 		mouseEvent.action = action;
 		mouseEvent.mods = mods;
 
-		EventBus::publish(mouseEvent);
+		EventQueue::post(mouseEvent);
 	}
 
 	void Application::scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 	{
+		if (InputRecorder::IsReplaying())
+			return;
+
 		MouseScrollEvent event;
 		event.offset = { (float)xoffset,(float)yoffset };
 
-		EventBus::publish(event);
+		EventQueue::post(event);
 	}
 
-	void Application::onMouseScrollDispatch(Event& event)
+	void Application::onMouseScrollDispatch(MouseScrollEvent& mouseScroll)
 	{
-		MouseScrollEvent* mouseScroll = (MouseScrollEvent*)&event;
 		if (editor->GetViewPortAction() == ViewPortAction::Idle)
 		{
 			auto camera = scene->GetSceneCamera();
@@ -310,23 +523,18 @@ namespace Iaonnis
 
 			glm::vec3 viewDirection = camera->getViewDirection();
 			glm::vec3 currentPosition = frustrum.position;
-			glm::vec3 newPosition = currentPosition + viewDirection * mouseScroll->offset.y * 0.1f;
+			glm::vec3 newPosition = currentPosition + viewDirection * mouseScroll.offset.y * 0.1f;
 			camera->setPosition(newPosition);
 		}
 	}
 
-	void Application::onMouseClickDispatch(Event& event)
+	void Application::onMouseClickDispatch(MouseClickedEvent&)
 	{
-		
 
-		MouseClickedEvent* mouseEvent = (MouseClickedEvent*)&event;
-		
 	}
 
-	void Application::onMouseMoveDispatch(Event& event)
+	void Application::onMouseMoveDispatch(MouseMoveEvent& mouseEvent)
 	{
-		MouseMoveEvent* mouseEvent = (MouseMoveEvent*)&event;
-
 		if (editor->GetViewPortAction() == ViewPortAction::Orbit)
 		{
 			auto camera = scene->GetSceneCamera();
@@ -335,8 +543,8 @@ namespace Iaonnis
 			float delta_angleX = (2 * glm::pi<float>()) / 1600.0f;
 			float delta_angleY = glm::pi<float>() / 900.0f;
 
-			float angleX = (inputState.lastMousePosition.x - mouseEvent->position.x) * delta_angleX;
-			float angleY = (inputState.lastMousePosition.y - mouseEvent->position.y) * delta_angleY;
+			float angleX = (inputState.lastMousePosition.x - mouseEvent.position.x) * delta_angleX;
+			float angleY = (inputState.lastMousePosition.y - mouseEvent.position.y) * delta_angleY;
 
 			// Clamp Y rotation to prevent flipping
 			float cosAngle = glm::dot(camera->getViewDirection(), glm::vec3(0.0, 1.0, 0.0));
@@ -359,8 +567,8 @@ namespace Iaonnis
 			glm::vec3 newPosition = glm::vec3(relativePosition) + frustrum.target;
 			camera->setPosition(newPosition);
 
-			inputState.lastMousePosition.x = mouseEvent->position.x;
-			inputState.lastMousePosition.y = mouseEvent->position.y;
+			inputState.lastMousePosition.x = mouseEvent.position.x;
+			inputState.lastMousePosition.y = mouseEvent.position.y;
 		}
 
 		if (editor->GetViewPortAction() == ViewPortAction::Pan)
@@ -368,10 +576,10 @@ namespace Iaonnis
 			auto camera = scene->GetSceneCamera();
 			auto frustrum = camera->getFrustrum();
 
-			float diffX = mouseEvent->position.x - inputState.lastMousePosition.x;
-			float diffY = mouseEvent->position.y - inputState.lastMousePosition.y;
+			float diffX = mouseEvent.position.x - inputState.lastMousePosition.x;
+			float diffY = mouseEvent.position.y - inputState.lastMousePosition.y;
 
-			inputState.lastMousePosition = mouseEvent->position;
+			inputState.lastMousePosition = mouseEvent.position;
 
 			// Scale panning speed relative to camera distance from target
 			float distance = glm::length(frustrum.position - frustrum.target);
@@ -386,25 +594,39 @@ namespace Iaonnis
 			camera->updateTarget(displacement);
 		}
 
-		inputState.lastMousePosition.x = mouseEvent->position.x;
-		inputState.lastMousePosition.y = mouseEvent->position.y;
+		inputState.lastMousePosition.x = mouseEvent.position.x;
+		inputState.lastMousePosition.y = mouseEvent.position.y;
 	}
 
-	void Application::onKeyPressedEvent(Event& event)
+	void Application::onKeyPressedEvent(KeyPressEvent& keyEvent)
 	{
-		KeyPressEvent* keyEvent = (KeyPressEvent*)&event;
-		
+		//Held keys are tracked from the events rather than polled from GLFW, so a replay moves the camera exactly like the recording.
+		if (keyEvent.keyCode >= 0 && keyEvent.keyCode < (int)inputState.keysDown.size())
+			inputState.keysDown[keyEvent.keyCode] = keyEvent.action != GLFW_RELEASE;
+
 		auto camera = scene->GetSceneCamera();
 		auto frustrum = camera->getFrustrum();
-		
-		/*float cameraSpeed = 0.0000005f;
-		if (keyEvent->keyCode == GLFW_KEY_W && keyEvent->action == GLFW_PRESS)
-			camera->updatePosition(frustrum.target * cameraSpeed);
-		if (keyEvent->keyCode == GLFW_KEY_S && keyEvent->action == GLFW_PRESS)
-			camera->updatePosition(-frustrum.target * cameraSpeed);
-		if (keyEvent->keyCode == GLFW_KEY_A && keyEvent->action == GLFW_PRESS)
-			camera->updatePosition(-glm::normalize(glm::cross(frustrum.target, frustrum.up)) * cameraSpeed);
-		if (keyEvent->keyCode == GLFW_KEY_D && keyEvent->action == GLFW_PRESS)
-			camera->updatePosition(glm::normalize(glm::cross(frustrum.target, frustrum.up)) * cameraSpeed);*/
+
+		float cameraSpeed = 0.5f;
+		glm::vec3 direction = glm::normalize(frustrum.target - frustrum.position);
+		glm::vec3 right = glm::normalize(glm::cross(direction, frustrum.up));
+		glm::vec3 strafe = right * cameraSpeed;
+
+		if (inputState.keysDown[GLFW_KEY_W])
+			camera->updatePosition(direction * cameraSpeed);
+		if (inputState.keysDown[GLFW_KEY_S])
+			camera->updatePosition(-direction * cameraSpeed);
+		if (inputState.keysDown[GLFW_KEY_A])
+		{
+			camera->setPosition(frustrum.position - strafe);
+			camera->setTarget(frustrum.target - strafe);
+		}
+		if (inputState.keysDown[GLFW_KEY_D])
+		{
+			camera->setPosition(frustrum.position + strafe);
+			camera->setTarget(frustrum.target + strafe);
+		}
+
+		IAONNIS_LOG_DEBUG("Camera Location:: %.3f ,%.3f, %.3f", frustrum.position.x, frustrum.position.y, frustrum.position.z);
 	}
-}
+}
\ No newline at end of file
@@ -6,13 +6,26 @@
 #include "Editor/editor.h"
 #include "Renderer/Renderer.h"
 
+#include <bitset>
+
 
 namespace Iaonnis
 {
+	/// @brief FrameStats channels fed by the application every frame.
+	struct FrameStatChannels
+	{
+		uint32_t frameTime = 0;
+		uint32_t drawCalls = 0;
+		uint32_t vertices = 0;
+		std::vector<uint32_t> stages;
+		uint32_t passes[(int)Renderer3D::RenderPass::Count] = {};
+	};
+
 	struct InputState
 	{
 		glm::vec2 lastMousePosition = glm::vec2(0.0f, 0.0f);
 		glm::vec2 viewPortSize = glm::vec2(0.0f, 0.0f);
+		std::bitset<GLFW_KEY_LAST + 1> keysDown;
 	};
 
 	class Application
@@ -20,9 +33,17 @@ namespace Iaonnis
 	public:
 		void InitializeApplication();
 		void OnUpdate();
-		void Shutdown();
+
+		/// @brief Returns the process exit code, non-zero if the zero-allocation test failed.
+		int Shutdown();
 	private:
-		void closeApp(Event& event);
+		void BuildFrameGraph();
+		void RegisterFrameStats();
+		void RecordFrameStats(double frameTimeMs);
+		bool IsSteadyStateFrame(uint64_t frame)const;
+		void ReportAllocationViolations();
+
+		void closeApp(ExitAppEvent& event);
 		static void window_resize_callback(GLFWwindow* window, int x, int y);
 		static void window_close_callback(GLFWwindow* window);
 		static void cursor_position_callback(GLFWwindow* window, double xpos, double ypos);
@@ -30,16 +51,23 @@ namespace Iaonnis
 		static void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
 		static void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
 
-		void onMouseScrollDispatch(Event& event);
-		void onMouseClickDispatch(Event& event);
-		void onMouseMoveDispatch(Event& event);
-		void onKeyPressedEvent(Event& event);
+		void onMouseScrollDispatch(MouseScrollEvent& event);
+		void onMouseClickDispatch(MouseClickedEvent& event);
+		void onMouseMoveDispatch(MouseMoveEvent& event);
+		void onKeyPressedEvent(KeyPressEvent& event);
 	private:
 		InputState inputState;
 	private:
 		std::shared_ptr<Editor> editor;
 		std::shared_ptr<Scene> scene;
 		uint32_t program;
+
+		TaskGraph frameGraph;
+		FrameStatChannels frameStatChannels;
+
+		/// @brief Steady-state frames the zero-allocation test still has to check, 0 when it is not running.
+		uint32_t zeroAllocationFramesLeft = 0;
+		int exitCode = 0;
 	private:
 		GLFWwindow* window;
 		int windowWidth;
@@ -5,5 +5,16 @@
 #include "UUID.h"
 #include "Timer.h"
 #include "Event.h"
+#include "EventQueue.h"
 #include "Utils.h"
-#include "SimpleTimer.h"
\ No newline at end of file
+#include "SimpleTimer.h"
+#include "Job.h"
+#include "TaskGraph.h"
+#include "IO.h"
+#include "Task.h"
+#include "FrameAllocator.h"
+#include "StringId.h"
+#include "Memory.h"
+#include "Profiler.h"
+#include "FrameStats.h"
+#include "InputRecorder.h"
\ No newline at end of file
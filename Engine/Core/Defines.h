@@ -6,8 +6,12 @@
 #define PI 3.141592.0
 
 #define IAONNIS_ASSERT(expression,msg)                                \
-if (!(expression))                                              \
+do                                                              \
 {                                                               \
-    IAONNIS_LOG_ERROR("Assertion failed: %s", msg);                 \
-    assert(expression && msg);                              \
-}
\ No newline at end of file
+    if (!(expression))                                          \
+    {                                                           \
+        IAONNIS_LOG_ERROR("Assertion failed: %s", msg);             \
+        ::Iaonnis::Log::Flush();                                    \
+        assert((expression) && (msg));                              \
+    }                                                           \
+} while (0)
@@ -2,35 +2,65 @@
 
 namespace Iaonnis {
 
-	std::unordered_map<EventType, std::vector<EventBus::Listener>>EventBus::m_Listeners;
+	EventBus::ListenerList EventBus::m_Listeners[(int)EventType::Count];
+	uint32_t EventBus::m_NextListenerId = 1;
 
-	void EventBus::subscribe(EventType eventType, Listener listener)
+	EventListenerHandle EventBus::AddListener(EventType eventType, void* instance, Thunk thunk)
 	{
-		m_Listeners[eventType].push_back(listener);
-	}
+		EventListenerHandle handle;
+		handle.eventType = eventType;
+		handle.id = m_NextListenerId++;
 
+		m_Listeners[(int)eventType].listeners.push_back({ instance, thunk, handle.id });
+		return handle;
+	}
 
-	void EventBus::publish(Event& event)
+	void EventBus::unsubscribe(EventListenerHandle& handle)
 	{
-		auto subs = m_Listeners[event.eventType];
-		for (auto& listener : subs)
+		if (!handle.IsValid())
+			return;
+
+		ListenerList& list = m_Listeners[(int)handle.eventType];
+		for (size_t i = 0; i < list.listeners.size(); i++)
 		{
-			listener(event);
+			if (list.listeners[i].id != handle.id)
+				continue;
 
-			if (event.handled)break;
+			//A dispatch may be iterating the list, only clear the slot then.
+			if (list.dispatchDepth > 0)
+			{
+				list.listeners[i].thunk = nullptr;
+				list.hasRemoved = true;
+			}
+			else
+				list.listeners.erase(list.listeners.begin() + i);
+			break;
 		}
-		return;
+
+		handle = {};
 	}
 
-	void EventBus::publish(Feedback& event)
+	void EventBus::Dispatch(EventType eventType, Event& event)
 	{
-		auto subs = m_Listeners[event.eventType];
-		for (auto& listener : subs)
+		ListenerList& list = m_Listeners[(int)eventType];
+		list.dispatchDepth++;
+
+		//Indexed and copied one at a time: listeners may subscribe while we iterate.
+		for (size_t i = 0; i < list.listeners.size(); i++)
 		{
-			listener(event);
+			Listener listener = list.listeners[i];
+			if (!listener.thunk)
+				continue;
+
+			listener.thunk(listener.instance, event);
 
 			if (event.handled)break;
 		}
-		return;
+
+		if (--list.dispatchDepth == 0 && list.hasRemoved)
+		{
+			list.listeners.erase(std::remove_if(list.listeners.begin(), list.listeners.end(), [](const Listener& listener) { return !listener.thunk; }), list.listeners.end());
+			list.hasRemoved = false;
+		}
 	}
-}
\ No newline at end of file
+}
@@ -1,10 +1,11 @@
 #pragma once
 #include "pch.h"
+#include "UUID.h"
 
 namespace Iaonnis {
 
 #define IAONNISE_PUBLISH_EVENT(event) EventBus::publish(event);
-#define IAONNIS_SUBSCRIBE_EVENT(event_type,func) EventBus::subscribe(event_type,func);
+#define IAONNIS_SUBSCRIBE_EVENT(EventT,function) EventBus::subscribe<EventT, function>();
 	enum class EventType
 	{
 		LOG_EVENT,
@@ -15,6 +16,9 @@ namespace Iaonnis {
 		MOUSE_MOVE_EVENT,
 		MOUSE_CLICKED_EVENT,
 		MOUSE_SCROLLED_EVENT,
+		RESOURCE_LOADED_EVENT,
+
+		Count
 	};
 
 	struct Event
@@ -27,16 +31,14 @@ namespace Iaonnis {
 		{
 
 		}
-		Event(const Event& other)
-			:eventType(other.eventType), handled(other.handled)
-		{
-		}
 	};
 
 	struct KeyPressEvent : public Event
 	{
+		static constexpr EventType Type = EventType::KEY_PRESS_EVENT;
+
 		KeyPressEvent()
-			: Event(EventType::KEY_PRESS_EVENT)
+			: Event(Type)
 		{
 
 		}
@@ -48,8 +50,10 @@ namespace Iaonnis {
 
 	struct MouseScrollEvent : public Event
 	{
+		static constexpr EventType Type = EventType::MOUSE_SCROLLED_EVENT;
+
 		MouseScrollEvent()
-			:Event(EventType::MOUSE_SCROLLED_EVENT)
+			:Event(Type)
 		{
 
 		}
@@ -58,8 +62,10 @@ namespace Iaonnis {
 
 	struct MouseMoveEvent : public Event
 	{
+		static constexpr EventType Type = EventType::MOUSE_MOVE_EVENT;
+
 		MouseMoveEvent()
-			:Event(EventType::MOUSE_MOVE_EVENT)
+			:Event(Type)
 		{
 
 		}
@@ -70,8 +76,10 @@ namespace Iaonnis {
 
 	struct MouseClickedEvent : public Event
 	{
+		static constexpr EventType Type = EventType::MOUSE_CLICKED_EVENT;
+
 		MouseClickedEvent()
-			:Event(EventType::MOUSE_CLICKED_EVENT)
+			:Event(Type)
 		{
 
 		}
@@ -83,21 +91,39 @@ namespace Iaonnis {
 
 	struct LogEvent :public Event
 	{
-		std::string message;
-		LogEvent(const char* msg)
-			:Event(EventType::LOG_EVENT)
+		static constexpr EventType Type = EventType::LOG_EVENT;
+
+		/// @brief Only valid during dispatch, listeners that keep it must copy it.
+		std::string_view message;
+		LogEvent(std::string_view msg)
+			:Event(Type), message(msg)
 		{
-			message = msg;
 		}
 	};
 
 	struct FrameResizeEvent : public Event
 	{
+		static constexpr EventType Type = EventType::RESIZE_EVENT;
+
 		float frameSizeX;
 		float frameSizeY;
 
 		FrameResizeEvent()
-			:Event(EventType::RESIZE_EVENT)
+			:Event(Type)
+		{
+
+		}
+	};
+
+	/// @brief Posted once a resource requested with ResourceCache::loadAsync() is in the cache.
+	struct ResourceLoadedEvent : public Event
+	{
+		static constexpr EventType Type = EventType::RESOURCE_LOADED_EVENT;
+
+		UUID resourceID;
+
+		ResourceLoadedEvent()
+			:Event(Type)
 		{
 
 		}
@@ -124,11 +150,13 @@ namespace Iaonnis {
 
 	struct PromptEvent : public Event
 	{
+		static constexpr EventType Type = EventType::PROMPT_EVENT;
+
 		std::string message;
 		std::string name;
 
 		PromptEvent(const char* promptName, const char* msg)
-			:Event(EventType::PROMPT_EVENT)
+			:Event(Type)
 		{
 			message = msg;
 			name = promptName;
@@ -160,24 +188,87 @@ namespace Iaonnis {
 
 	struct ExitAppEvent : public Feedback
 	{
+		static constexpr EventType Type = EventType::EXIT_APP_EVENT;
+
 		ExitAppEvent()
-			:Feedback(EventType::EXIT_APP_EVENT)
+			:Feedback(Type)
 		{
 
 		}
 	};
 
+	/// @brief Identifies a subscription for EventBus::unsubscribe(). id 0 is never handed out.
+	struct EventListenerHandle
+	{
+		EventType eventType = EventType::Count;
+		uint32_t id = 0;
+
+		bool IsValid()const { return id != 0; }
+	};
+
+	/// <summary>
+	/// Synchronous event dispatch, main thread only. Listeners are plain (instance, thunk) pairs stored contiguously
+	/// per event type; the event type is known at compile time from T::Type, so publishing neither looks anything up
+	/// nor allocates. Listeners receive the concrete event type.
+	/// Subscribing or unsubscribing from inside a listener is allowed, removed listeners are skipped and compacted
+	/// once the outermost dispatch of their type returns.
+	/// </summary>
 	class EventBus
 	{
 	public:
-		using Listener = std::function<void(Event&)>;
+		using Thunk = void(*)(void* instance, Event& event);
+
+		/// @brief Subscribes a free function: EventBus::subscribe<FrameResizeEvent, &OnResize>().
+		template <typename T, void (*Function)(T&)>
+		static EventListenerHandle subscribe()
+		{
+			static_assert(std::is_base_of_v<Event, T>, "T must derive from Event.");
+			return AddListener(T::Type, nullptr, [](void*, Event& event) { Function(static_cast<T&>(event)); });
+		}
+
+		/// @brief Subscribes a member function: EventBus::subscribe<FrameResizeEvent, &Scene::OnResize>(this).
+		/// The instance must unsubscribe before it is destroyed.
+		template <typename T, auto Method, typename Class>
+		static EventListenerHandle subscribe(Class* instance)
+		{
+			static_assert(std::is_base_of_v<Event, T>, "T must derive from Event.");
+			return AddListener(T::Type, instance, [](void* instance, Event& event) { (static_cast<Class*>(instance)->*Method)(static_cast<T&>(event)); });
+		}
+
+		/// @brief Removes the listener and resets handle. Does nothing for an invalid or already removed handle.
+		static void unsubscribe(EventListenerHandle& handle);
+
+		template <typename T>
+		static void publish(T& event)
+		{
+			static_assert(std::is_base_of_v<Event, T>, "T must derive from Event.");
+			Dispatch(T::Type, event);
+		}
+
+		/// @brief Dispatches on event.eventType, for events whose type is only known at runtime (prompt feedback).
+		static void publish(Event& event) { Dispatch(event.eventType, event); }
+
+	private:
+		struct Listener
+		{
+			void* instance = nullptr;
+			Thunk thunk = nullptr;
+			uint32_t id = 0;
+		};
+
+		struct ListenerList
+		{
+			std::vector<Listener> listeners;
+			uint32_t dispatchDepth = 0;
+			bool hasRemoved = false;
+		};
 
-		static void subscribe(EventType eventType, Listener listener);
-		static void publish(Event& event);
-		static void publish(Feedback& event);
+		static EventListenerHandle AddListener(EventType eventType, void* instance, Thunk thunk);
+		static void Dispatch(EventType eventType, Event& event);
 
 	private:
-		static std::unordered_map<EventType, std::vector<Listener>>m_Listeners;
+		static ListenerList m_Listeners[(int)EventType::Count];
+		static uint32_t m_NextListenerId;
 	};
 
 	class EventFeedback
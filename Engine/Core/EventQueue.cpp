@@ -0,0 +1,86 @@
+#include "EventQueue.h"
+#include "Profiler.h"
+
+namespace Iaonnis {
+
+	EventQueue::Policy EventQueue::m_Policies[(int)EventType::Count];
+
+	std::mutex EventQueue::m_Mutex;
+	std::vector<EventQueue::Entry> EventQueue::m_Pending;
+	std::vector<EventQueue::Entry> EventQueue::m_Dispatching;
+
+	EventQueueStats EventQueue::m_Counters;
+	EventQueueStats EventQueue::m_Stats;
+
+	void EventQueue::SetPolicy(EventType eventType, EventCoalescing mode, MergeFunction merge)
+	{
+		Policy& policy = m_Policies[(int)eventType];
+		policy.mode = mode;
+		policy.merge = std::move(merge);
+	}
+
+	void EventQueue::Post(EventType eventType, uint64_t key, const void* event, size_t size, PublishThunk publish)
+	{
+		const Policy& policy = m_Policies[(int)eventType];
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Counters.posted++;
+
+		if (policy.mode != EventCoalescing::None)
+		{
+			//Few events are pending at once, a scan is cheaper than keeping a lookup in sync.
+			for (Entry& entry : m_Pending)
+			{
+				if (entry.eventType != eventType || entry.key != key)
+					continue;
+
+				//Merge runs on the posting thread under the queue lock.
+				if (policy.mode == EventCoalescing::Replace)
+					memcpy(entry.storage, event, size);
+				else
+					policy.merge(*reinterpret_cast<Event*>(entry.storage), *static_cast<const Event*>(event));
+
+				m_Counters.coalesced++;
+				return;
+			}
+		}
+
+		Entry& entry = m_Pending.emplace_back();
+		entry.eventType = eventType;
+		entry.key = key;
+		entry.publish = publish;
+		memcpy(entry.storage, event, size);
+	}
+
+	void EventQueue::Dispatch()
+	{
+		IAONNIS_PROFILE_FUNCTION();
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			//Both vectors keep their capacity, so a steady frame does not allocate here.
+			std::swap(m_Pending, m_Dispatching);
+			m_Stats = m_Counters;
+			m_Counters = {};
+		}
+
+		for (Entry& entry : m_Dispatching)
+			entry.publish(entry.storage);
+
+		m_Stats.dispatched = (uint32_t)m_Dispatching.size();
+		m_Dispatching.clear();
+	}
+
+	void EventQueue::Clear()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Pending.clear();
+		m_Counters = {};
+	}
+
+	EventQueueStats EventQueue::GetStats()
+	{
+		return m_Stats;
+	}
+}
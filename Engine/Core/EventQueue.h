@@ -0,0 +1,112 @@
+#pragma once
+#include "pch.h"
+#include "Defines.h"
+#include "Event.h"
+
+#include <mutex>
+
+namespace Iaonnis {
+
+	//Bytes of inline storage per queued event. Events are copied in, larger ones do not compile.
+#define IAONNIS_EVENT_QUEUE_EVENT_SIZE 64
+
+	enum class EventCoalescing
+	{
+		/// @brief Every post is dispatched.
+		None,
+
+		/// @brief A post replaces the pending event of the same type and key, e.g. the last resize wins.
+		Replace,
+
+		/// @brief A post is folded into the pending event of the same type and key by the type's merge function.
+		Merge
+	};
+
+	struct EventQueueStats
+	{
+		/// @brief Counted over the last Dispatch(): posts received, posts folded into a pending event and events published.
+		uint32_t posted = 0;
+		uint32_t coalesced = 0;
+		uint32_t dispatched = 0;
+	};
+
+	/// <summary>
+	/// Deferred events. post() may be called from any thread, the events are published through EventBus when the main
+	/// thread calls Dispatch() at the start of the frame, in the order they were first posted.
+	/// Pending events of a type with a coalescing policy are matched by (type, key): a new post replaces or merges into the
+	/// pending one instead of being queued again, so a burst of resizes or mouse moves costs one dispatch per frame.
+	/// Events posted by listeners while Dispatch() runs are published by the next Dispatch().
+	/// Events are stored by value: they must be trivially copyable and must not point at memory that dies before the drain.
+	/// </summary>
+	class EventQueue
+	{
+	public:
+		/// @brief Merges incoming into pending, both of the type the function was set for.
+		using MergeFunction = std::function<void(Event& pending, const Event& incoming)>;
+
+		/// @brief Sets how posts of T are coalesced. Configure before anything posts T, the policies are not locked.
+		template <typename T>
+		static void setCoalescing(EventCoalescing mode)
+		{
+			static_assert(std::is_base_of_v<Event, T>, "T must derive from Event.");
+			IAONNIS_ASSERT(mode != EventCoalescing::Merge, "Merge coalescing needs a merge function.");
+			SetPolicy(T::Type, mode, {});
+		}
+
+		/// @brief Merge coalescing: EventQueue::setCoalescing<MouseMoveEvent>([](MouseMoveEvent& pending, const MouseMoveEvent& incoming) {...}).
+		template <typename T>
+		static void setCoalescing(void (*merge)(T& pending, const T& incoming))
+		{
+			static_assert(std::is_base_of_v<Event, T>, "T must derive from Event.");
+			SetPolicy(T::Type, EventCoalescing::Merge, [merge](Event& pending, const Event& incoming) { merge(static_cast<T&>(pending), static_cast<const T&>(incoming)); });
+		}
+
+		template <typename T>
+		static void post(const T& event, uint64_t key = 0)
+		{
+			static_assert(std::is_base_of_v<Event, T>, "T must derive from Event.");
+			static_assert(std::is_trivially_copyable_v<T>, "Queued events are copied as bytes and must be trivially copyable.");
+			static_assert(sizeof(T) <= IAONNIS_EVENT_QUEUE_EVENT_SIZE && alignof(T) <= alignof(std::max_align_t), "Event too large for IAONNIS_EVENT_QUEUE_EVENT_SIZE.");
+
+			Post(T::Type, key, &event, sizeof(T), [](void* storage) { EventBus::publish(*static_cast<T*>(storage)); });
+		}
+
+		/// @brief Publishes every pending event. Main thread only.
+		static void Dispatch();
+
+		/// @brief Drops pending events without publishing them.
+		static void Clear();
+
+		static EventQueueStats GetStats();
+
+	private:
+		using PublishThunk = void(*)(void* storage);
+
+		struct Entry
+		{
+			EventType eventType = EventType::Count;
+			uint64_t key = 0;
+			PublishThunk publish = nullptr;
+			alignas(std::max_align_t) uint8_t storage[IAONNIS_EVENT_QUEUE_EVENT_SIZE];
+		};
+
+		struct Policy
+		{
+			EventCoalescing mode = EventCoalescing::None;
+			MergeFunction merge;
+		};
+
+		static void SetPolicy(EventType eventType, EventCoalescing mode, MergeFunction merge);
+		static void Post(EventType eventType, uint64_t key, const void* event, size_t size, PublishThunk publish);
+
+	private:
+		static Policy m_Policies[(int)EventType::Count];
+
+		static std::mutex m_Mutex;
+		static std::vector<Entry> m_Pending;
+		static std::vector<Entry> m_Dispatching;
+
+		static EventQueueStats m_Counters;
+		static EventQueueStats m_Stats;
+	};
+}
@@ -0,0 +1,108 @@
+#include "FrameAllocator.h"
+#include "Defines.h"
+
+namespace Iaonnis {
+
+	uint8_t* FrameAllocator::buffer = nullptr;
+	size_t FrameAllocator::capacity = 0;
+	std::atomic<size_t> FrameAllocator::offset{ 0 };
+
+	std::atomic<bool> FrameAllocator::resetting{ false };
+	std::thread::id FrameAllocator::owner;
+
+	std::mutex FrameAllocator::overflowMutex;
+	std::vector<std::pair<void*, size_t>> FrameAllocator::overflowBlocks;
+	size_t FrameAllocator::overflowBytes = 0;
+
+	FrameAllocatorStats FrameAllocator::lastStats;
+
+	void FrameAllocator::Initialize(size_t bytes)
+	{
+		Shutdown();
+
+		owner = std::this_thread::get_id();
+		capacity = bytes;
+		buffer = static_cast<uint8_t*>(::operator new(capacity, std::align_val_t(alignof(std::max_align_t))));
+		offset.store(0, std::memory_order_relaxed);
+
+		overflowBlocks.reserve(64);
+	}
+
+	void FrameAllocator::Shutdown()
+	{
+		Reset();
+
+		if (buffer)
+			::operator delete(buffer, std::align_val_t(alignof(std::max_align_t)));
+
+		buffer = nullptr;
+		capacity = 0;
+	}
+
+	void* FrameAllocator::Allocate(size_t size, size_t alignment)
+	{
+		IAONNIS_ASSERT(!resetting.load(std::memory_order_relaxed), "Frame allocation raced with FrameAllocator::Reset().");
+
+		size_t current = offset.load(std::memory_order_relaxed);
+		while (buffer)
+		{
+			uintptr_t base = reinterpret_cast<uintptr_t>(buffer);
+			size_t aligned = ((base + current + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+			size_t next = aligned + size;
+
+			if (next > capacity)
+				break;
+
+			if (offset.compare_exchange_weak(current, next, std::memory_order_relaxed))
+				return buffer + aligned;
+		}
+
+		return AllocateOverflow(size, alignment);
+	}
+
+	void* FrameAllocator::AllocateOverflow(size_t size, size_t alignment)
+	{
+		void* memory = ::operator new(size, std::align_val_t(alignment));
+
+		std::lock_guard<std::mutex> lock(overflowMutex);
+		overflowBlocks.emplace_back(memory, alignment);
+		overflowBytes += size + alignment;
+
+		return memory;
+	}
+
+	void FrameAllocator::Reset()
+	{
+		IAONNIS_ASSERT(owner == std::thread::id() || owner == std::this_thread::get_id(), "FrameAllocator::Reset() called off the owning thread.");
+		resetting.store(true, std::memory_order_relaxed);
+
+		size_t used = offset.exchange(0, std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> lock(overflowMutex);
+		for (auto& [memory, alignment] : overflowBlocks)
+			::operator delete(memory, std::align_val_t(alignment));
+		overflowBlocks.clear();
+
+		lastStats.used = used;
+		lastStats.overflow = overflowBytes;
+		lastStats.peak = std::max(lastStats.peak, used + overflowBytes);
+
+		//Grow once so the same workload fits next frame without touching the heap again.
+		if (overflowBytes > 0 && buffer)
+		{
+			size_t newCapacity = std::max(capacity * 2, used + overflowBytes);
+			::operator delete(buffer, std::align_val_t(alignof(std::max_align_t)));
+			buffer = static_cast<uint8_t*>(::operator new(newCapacity, std::align_val_t(alignof(std::max_align_t))));
+			capacity = newCapacity;
+		}
+		overflowBytes = 0;
+
+		lastStats.capacity = capacity;
+		resetting.store(false, std::memory_order_relaxed);
+	}
+
+	FrameAllocatorStats FrameAllocator::GetStats()
+	{
+		return lastStats;
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "pch.h"
+
+#include <atomic>
+
+namespace Iaonnis {
+
+#define IAONNIS_FRAME_ALLOCATOR_CAPACITY (4 * 1024 * 1024)
+
+	struct FrameAllocatorStats
+	{
+		size_t used = 0;
+		size_t capacity = 0;
+		size_t peak = 0;
+
+		/// @brief Bytes that did not fit last frame and came from the heap. The arena grows to cover them on Reset().
+		size_t overflow = 0;
+	};
+
+	/// <summary>
+	/// Linear allocator for data that only lives for the current frame.
+	/// Allocation is a single atomic bump so any thread may allocate, nothing is freed individually.
+	/// Everything is released at once by Reset(), which the application calls between frames. Reset() may move the
+	/// arena, so allocating is only legal inside the frame stages: no job that allocates or holds frame memory may
+	/// still be running when Reset() is called.
+	/// </summary>
+	class FrameAllocator
+	{
+	public:
+		static void Initialize(size_t capacity = IAONNIS_FRAME_ALLOCATOR_CAPACITY);
+		static void Shutdown();
+
+		/// @brief Falls back to the heap when the arena is full (or not initialized) so callers never fail.
+		static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		/// @brief Releases every frame allocation. No pointer handed out before the call may be used afterwards.
+		/// Call from the thread that called Initialize(), with no other thread inside Allocate().
+		static void Reset();
+
+		static FrameAllocatorStats GetStats();
+
+	private:
+		static void* AllocateOverflow(size_t size, size_t alignment);
+
+	private:
+		static uint8_t* buffer;
+		static size_t capacity;
+		static std::atomic<size_t> offset;
+
+		//Catches allocations racing a Reset(), which would bump into a freed or recycled arena.
+		static std::atomic<bool> resetting;
+		static std::thread::id owner;
+
+		static std::mutex overflowMutex;
+		static std::vector<std::pair<void*, size_t>> overflowBlocks;
+		static size_t overflowBytes;
+
+		static FrameAllocatorStats lastStats;
+	};
+
+	/// @brief STL allocator over the FrameAllocator. deallocate() is a no-op, memory comes back on Reset().
+	template<class T>
+	struct FrameAllocatorAdapter
+	{
+		using value_type = T;
+
+		FrameAllocatorAdapter() = default;
+
+		template<class U>
+		FrameAllocatorAdapter(const FrameAllocatorAdapter<U>&)noexcept {}
+
+		T* allocate(size_t count)
+		{
+			return static_cast<T*>(FrameAllocator::Allocate(count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T*, size_t)noexcept {}
+
+		template<class U>
+		bool operator==(const FrameAllocatorAdapter<U>&)const noexcept { return true; }
+
+		template<class U>
+		bool operator!=(const FrameAllocatorAdapter<U>&)const noexcept { return false; }
+	};
+
+	/// @brief Vector whose storage is only valid until the end of the frame. Never keep one across frames.
+	template<class T>
+	using FrameVector = std::vector<T, FrameAllocatorAdapter<T>>;
+}
@@ -0,0 +1,181 @@
+#include "FrameStats.h"
+#include "Log.h"
+
+#include <fstream>
+
+namespace Iaonnis {
+
+	namespace {
+
+		struct Channel
+		{
+			std::string name;
+			std::vector<float> history = std::vector<float>(IAONNIS_FRAME_STATS_HISTORY, 0.0f);
+			double current = 0.0;
+		};
+
+		struct FrameStatsData
+		{
+			std::vector<Channel> channels;
+			std::unordered_map<std::string, uint32_t> lookup;
+
+			//Committed frames, the newest sits at (frameCount - 1) % IAONNIS_FRAME_STATS_HISTORY.
+			uint64_t frameCount = 0;
+
+			std::ofstream csv;
+			filespace::filepath csvPath;
+			uint32_t csvChannelCount = 0;
+
+			std::vector<float> scratch;
+		};
+
+		FrameStatsData& GetData()
+		{
+			static FrameStatsData data;
+			return data;
+		}
+	}
+
+	double FrameStats::Percentile(std::vector<float>& values, double percentile)
+	{
+		if (values.empty())
+			return 0.0;
+
+		size_t index = (size_t)(percentile * (values.size() - 1) + 0.5);
+		std::nth_element(values.begin(), values.begin() + index, values.end());
+		return values[index];
+	}
+
+	uint32_t FrameStats::RegisterChannel(const std::string& name)
+	{
+		FrameStatsData& data = GetData();
+
+		auto it = data.lookup.find(name);
+		if (it != data.lookup.end())
+			return it->second;
+
+		uint32_t channel = (uint32_t)data.channels.size();
+		data.channels.emplace_back();
+		data.channels.back().name = name;
+		data.lookup.emplace(name, channel);
+		return channel;
+	}
+
+	uint32_t FrameStats::GetChannelCount()
+	{
+		return (uint32_t)GetData().channels.size();
+	}
+
+	const std::string& FrameStats::GetChannelName(uint32_t channel)
+	{
+		return GetData().channels[channel].name;
+	}
+
+	void FrameStats::Record(uint32_t channel, double value)
+	{
+		GetData().channels[channel].current = value;
+	}
+
+	void FrameStats::EndFrame()
+	{
+		FrameStatsData& data = GetData();
+		size_t slot = data.frameCount % IAONNIS_FRAME_STATS_HISTORY;
+
+		for (Channel& channel : data.channels)
+		{
+			channel.history[slot] = (float)channel.current;
+			channel.current = 0.0;
+		}
+
+		if (data.csv.is_open())
+		{
+			data.csv << data.frameCount;
+			for (uint32_t i = 0; i < data.csvChannelCount; i++)
+				data.csv << ',' << data.channels[i].history[slot];
+			data.csv << '\n';
+		}
+
+		data.frameCount++;
+	}
+
+	FramePercentiles FrameStats::GetPercentiles(uint32_t channel, uint32_t window)
+	{
+		FrameStatsData& data = GetData();
+
+		FramePercentiles result;
+		GetHistory(channel, window ? window : IAONNIS_FRAME_STATS_HISTORY, data.scratch);
+		if (data.scratch.empty())
+			return result;
+
+		double sum = 0.0;
+		for (float value : data.scratch)
+		{
+			sum += value;
+			result.max = std::max(result.max, (double)value);
+		}
+
+		result.samples = (uint32_t)data.scratch.size();
+		result.average = sum / result.samples;
+		result.p50 = Percentile(data.scratch, 0.50);
+		result.p95 = Percentile(data.scratch, 0.95);
+		result.p99 = Percentile(data.scratch, 0.99);
+		return result;
+	}
+
+	void FrameStats::GetHistory(uint32_t channel, uint32_t count, std::vector<float>& out)
+	{
+		FrameStatsData& data = GetData();
+		out.clear();
+
+		uint64_t available = std::min<uint64_t>(data.frameCount, IAONNIS_FRAME_STATS_HISTORY);
+		count = (uint32_t)std::min<uint64_t>(count, available);
+
+		const std::vector<float>& history = data.channels[channel].history;
+		for (uint64_t frame = data.frameCount - count; frame < data.frameCount; frame++)
+			out.push_back(history[frame % IAONNIS_FRAME_STATS_HISTORY]);
+	}
+
+	uint64_t FrameStats::GetFrameCount()
+	{
+		return GetData().frameCount;
+	}
+
+	bool FrameStats::OpenCSV(const filespace::filepath& path)
+	{
+		FrameStatsData& data = GetData();
+		CloseCSV();
+
+		data.csv.open(path, std::ios::out | std::ios::trunc);
+		if (!data.csv.is_open())
+		{
+			IAONNIS_LOG_ERROR("Failed to open frame stats CSV. (Path = %s)", path.string().c_str());
+			return false;
+		}
+
+		data.csvPath = path;
+		data.csvChannelCount = (uint32_t)data.channels.size();
+
+		data.csv << "frame";
+		for (uint32_t i = 0; i < data.csvChannelCount; i++)
+			data.csv << ',' << data.channels[i].name;
+		data.csv << '\n';
+
+		IAONNIS_LOG_INFO("Writing frame stats. (Path = %s)", path.string().c_str());
+		return true;
+	}
+
+	void FrameStats::CloseCSV()
+	{
+		FrameStatsData& data = GetData();
+		if (!data.csv.is_open())
+			return;
+
+		data.csv.close();
+		IAONNIS_LOG_INFO("Frame stats written. (Path = %s)", data.csvPath.string().c_str());
+	}
+
+	bool FrameStats::IsWritingCSV()
+	{
+		return GetData().csv.is_open();
+	}
+}
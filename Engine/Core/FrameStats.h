@@ -0,0 +1,54 @@
+#pragma once
+#include "pch.h"
+#include "Utils.h"
+
+namespace Iaonnis {
+
+	//Frames of history kept per channel. One minute at 60 fps.
+#define IAONNIS_FRAME_STATS_HISTORY 3600
+
+	struct FramePercentiles
+	{
+		double p50 = 0.0;
+		double p95 = 0.0;
+		double p99 = 0.0;
+		double max = 0.0;
+		double average = 0.0;
+		uint32_t samples = 0;
+	};
+
+	/// <summary>
+	/// Rolling per-frame history of named values (frame time, stage times, draw calls...).
+	/// Values are written with Record() during the frame and committed by EndFrame(). A channel that
+	/// is not recorded in a frame repeats 0 for it. Percentiles are computed on demand over the last N frames.
+	/// When a CSV file is open every committed frame is appended to it as one row.
+	/// Main thread only.
+	/// </summary>
+	class FrameStats
+	{
+	public:
+		/// @brief Returns the channel for name, adding it the first time. Channels added after the CSV header
+		/// was written are not part of the CSV.
+		static uint32_t RegisterChannel(const std::string& name);
+		static uint32_t GetChannelCount();
+		static const std::string& GetChannelName(uint32_t channel);
+
+		static void Record(uint32_t channel, double value);
+		static void EndFrame();
+
+		/// @brief Percentiles over the last window frames (all of the history if window is 0).
+		static FramePercentiles GetPercentiles(uint32_t channel, uint32_t window = 0);
+
+		/// @brief Last count committed values of channel, oldest first.
+		static void GetHistory(uint32_t channel, uint32_t count, std::vector<float>& out);
+
+		static uint64_t GetFrameCount();
+
+		/// @brief Nearest-rank percentile (0..1) of values, which it reorders. 0 when values is empty.
+		static double Percentile(std::vector<float>& values, double percentile);
+
+		static bool OpenCSV(const filespace::filepath& path);
+		static void CloseCSV();
+		static bool IsWritingCSV();
+	};
+}
@@ -0,0 +1,729 @@
+#include "IO.h"
+#include "Log.h"
+#include "Profiler.h"
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/stat.h>
+#endif
+
+#if defined(__linux__)
+	#include <cerrno>
+	#include <linux/io_uring.h>
+	#include <sys/mman.h>
+	#include <sys/syscall.h>
+#endif
+
+namespace Iaonnis {
+
+	std::unique_ptr<IOBackend> IOService::backend = nullptr;
+
+	//=====================================Native Files===========================================
+
+	namespace
+	{
+		//Largest read issued in one call. Win32 ReadFile and io_uring both take 32 bit lengths.
+		const uint64_t MAX_READ_CHUNK = 1ull << 30;
+
+#ifdef _WIN32
+		using NativeFile = HANDLE;
+		const NativeFile INVALID_NATIVE_FILE = INVALID_HANDLE_VALUE;
+
+		NativeFile OpenNativeFile(const filespace::filepath& path)
+		{
+			return CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+				FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		}
+
+		bool GetNativeFileSize(NativeFile file, uint64_t& size)
+		{
+			LARGE_INTEGER fileSize;
+			if (!GetFileSizeEx(file, &fileSize))
+				return false;
+
+			size = (uint64_t)fileSize.QuadPart;
+			return true;
+		}
+
+		int64_t ReadNativeFile(NativeFile file, void* destination, uint64_t size, uint64_t offset)
+		{
+			OVERLAPPED overlapped{};
+			overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+			overlapped.OffsetHigh = (DWORD)(offset >> 32);
+
+			DWORD bytesRead = 0;
+			if (!::ReadFile(file, destination, (DWORD)size, &bytesRead, &overlapped))
+				return GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+
+			return (int64_t)bytesRead;
+		}
+
+		void CloseNativeFile(NativeFile file)
+		{
+			CloseHandle(file);
+		}
+#else
+		using NativeFile = int;
+		const NativeFile INVALID_NATIVE_FILE = -1;
+
+		NativeFile OpenNativeFile(const filespace::filepath& path)
+		{
+			return open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		}
+
+		bool GetNativeFileSize(NativeFile file, uint64_t& size)
+		{
+			struct stat fileStat;
+			if (fstat(file, &fileStat) != 0)
+				return false;
+
+			size = (uint64_t)fileStat.st_size;
+			return true;
+		}
+
+		int64_t ReadNativeFile(NativeFile file, void* destination, uint64_t size, uint64_t offset)
+		{
+			return (int64_t)pread(file, destination, (size_t)size, (off_t)offset);
+		}
+
+		void CloseNativeFile(NativeFile file)
+		{
+			close(file);
+		}
+#endif
+
+		/// @brief Resolves the number of bytes to read and where to put them.
+		/// Returns nullptr when there is nothing to read.
+		uint8_t* PrepareDestination(IORequest& request, IOResult& result, uint64_t fileSize, uint64_t& size)
+		{
+			size = request.size;
+			if (size == 0)
+				size = fileSize > request.offset ? fileSize - request.offset : 0;
+
+			if (size == 0)
+				return nullptr;
+
+			if (request.destination)
+				return static_cast<uint8_t*>(request.destination);
+
+			result.buffer.resize(size);
+			return result.buffer.data();
+		}
+	}
+
+	void IOService::ReadBlocking(IORequest& request, IOResult& result)
+	{
+		NativeFile file = OpenNativeFile(request.path);
+		if (file == INVALID_NATIVE_FILE)
+		{
+			result.status = IOStatus::FileNotFound;
+			return;
+		}
+
+		uint64_t fileSize = 0;
+		if (!GetNativeFileSize(file, fileSize))
+		{
+			CloseNativeFile(file);
+			result.status = IOStatus::ReadError;
+			return;
+		}
+
+		uint64_t size = 0;
+		uint8_t* destination = PrepareDestination(request, result, fileSize, size);
+
+		result.status = IOStatus::Success;
+		result.bytesRead = 0;
+		while (result.bytesRead < size)
+		{
+			uint64_t remaining = size - result.bytesRead;
+			uint64_t chunk = remaining < MAX_READ_CHUNK ? remaining : MAX_READ_CHUNK;
+
+			int64_t bytesRead = ReadNativeFile(file, destination + result.bytesRead, chunk, request.offset + result.bytesRead);
+			if (bytesRead < 0)
+			{
+				result.status = IOStatus::ReadError;
+				break;
+			}
+			if (bytesRead == 0)
+				break; //End of file
+
+			result.bytesRead += (uint64_t)bytesRead;
+		}
+
+		CloseNativeFile(file);
+
+		if (!request.destination)
+			result.buffer.resize(result.bytesRead);
+	}
+
+	//=====================================Thread Pool============================================
+
+	class ThreadPoolIOBackend : public IOBackend
+	{
+	public:
+		ThreadPoolIOBackend(uint32_t threadCount)
+		{
+			for (uint32_t i = 0; i < threadCount; i++)
+				threads.emplace_back(&ThreadPoolIOBackend::WorkerMain, this);
+		}
+
+		~ThreadPoolIOBackend()
+		{
+			{
+				std::lock_guard<std::mutex> lock(queueMutex);
+				running = false;
+			}
+			queueCondition.notify_all();
+
+			for (auto& thread : threads)
+				thread.join();
+		}
+
+		virtual void Submit(std::vector<IORequest>& requests) override
+		{
+			{
+				std::lock_guard<std::mutex> lock(queueMutex);
+				for (auto& request : requests)
+					pending.push_back(std::move(request));
+			}
+			queueCondition.notify_all();
+		}
+
+#ifdef _WIN32
+		virtual const char* GetName()const override { return "Thread Pool (ReadFile)"; }
+#else
+		virtual const char* GetName()const override { return "Thread Pool (pread)"; }
+#endif
+
+	private:
+		void WorkerMain()
+		{
+			IAONNIS_PROFILE_THREAD("IO Worker");
+
+			while (true)
+			{
+				IORequest request;
+				{
+					std::unique_lock<std::mutex> lock(queueMutex);
+					queueCondition.wait(lock, [this]() { return !pending.empty() || !running; });
+
+					//Queued requests are still completed on shutdown so no caller waits forever.
+					if (pending.empty())
+						return;
+
+					request = std::move(pending.front());
+					pending.pop_front();
+				}
+
+				IOResult result;
+				{
+					IAONNIS_PROFILE_SCOPE("IO Read");
+					IOService::ReadBlocking(request, result);
+				}
+
+				if (request.callback)
+					request.callback(result);
+			}
+		}
+
+	private:
+		std::vector<std::thread> threads;
+
+		std::mutex queueMutex;
+		std::condition_variable queueCondition;
+		std::deque<IORequest> pending;
+		bool running = true;
+	};
+
+	//=====================================io_uring===============================================
+
+#if defined(__linux__)
+	class IoUringBackend : public IOBackend
+	{
+	public:
+		static std::unique_ptr<IoUringBackend> Create(uint32_t entries)
+		{
+			std::unique_ptr<IoUringBackend> ring(new IoUringBackend());
+			if (!ring->Setup(entries))
+				return nullptr;
+
+			//Rings exist since 5.1 but IORING_OP_READ only since 5.6, older kernels take the thread pool instead.
+			if (!ring->SupportsRead())
+			{
+				IAONNIS_LOG_WARN("io_uring does not support IORING_OP_READ on this kernel.");
+				return nullptr;
+			}
+
+			ring->completionThread = std::thread(&IoUringBackend::CompletionMain, ring.get());
+			return ring;
+		}
+
+		~IoUringBackend()
+		{
+			if (completionThread.joinable())
+			{
+				running = false;
+
+				//A NOP wakes the completion thread if it is blocked waiting for completions.
+				{
+					std::lock_guard<std::mutex> lock(submitMutex);
+					if (!failed)
+					{
+						backlog.push_back(nullptr);
+						FlushBacklog();
+					}
+				}
+				completionThread.join();
+			}
+
+			if (sqes)
+				munmap(sqes, sqesSize);
+			if (cqRing && cqRing != sqRing)
+				munmap(cqRing, cqRingSize);
+			if (sqRing)
+				munmap(sqRing, sqRingSize);
+			if (ringFd >= 0)
+				close(ringFd);
+		}
+
+		virtual void Submit(std::vector<IORequest>& requests) override
+		{
+			std::vector<Operation*> finished;
+			{
+				std::lock_guard<std::mutex> lock(submitMutex);
+				for (auto& request : requests)
+				{
+					Operation* operation = new Operation();
+					operation->request = std::move(request);
+					activeOperations.fetch_add(1, std::memory_order_relaxed);
+
+					//Once the ring has failed nothing it is given would ever complete.
+					if (failed)
+					{
+						operation->result.status = IOStatus::ReadError;
+						finished.push_back(operation);
+						continue;
+					}
+
+					if (!Open(operation))
+					{
+						finished.push_back(operation);
+						continue;
+					}
+
+					backlog.push_back(operation);
+					inFlight.insert(operation);
+				}
+
+				FlushBacklog();
+			}
+
+			for (Operation* operation : finished)
+				Complete(operation);
+		}
+
+		virtual const char* GetName()const override { return "io_uring"; }
+
+	private:
+		struct Operation
+		{
+			IORequest request;
+			IOResult result;
+
+			int fd = -1;
+			uint8_t* destination = nullptr;
+			uint64_t size = 0;
+		};
+
+		IoUringBackend() = default;
+
+		bool SupportsRead()
+		{
+			//io_uring_probe is followed by one io_uring_probe_op per opcode.
+			const unsigned opCount = 256;
+			std::vector<uint64_t> storage((sizeof(io_uring_probe) + opCount * sizeof(io_uring_probe_op)) / sizeof(uint64_t) + 1);
+			io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+
+			//Kernels before 5.6 reject the probe, and they lack IORING_OP_READ as well.
+			if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, probe, opCount) < 0)
+				return false;
+
+			return probe->last_op >= IORING_OP_READ && (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED);
+		}
+
+		bool Setup(uint32_t entries)
+		{
+			io_uring_params params{};
+			ringFd = (int)syscall(__NR_io_uring_setup, entries, &params);
+			if (ringFd < 0)
+				return false;
+
+			sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+			cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+			bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+			if (singleMap)
+			{
+				if (cqRingSize > sqRingSize)
+					sqRingSize = cqRingSize;
+				cqRingSize = sqRingSize;
+			}
+
+			sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+			if (sqRing == MAP_FAILED)
+			{
+				sqRing = nullptr;
+				return false;
+			}
+
+			if (singleMap)
+				cqRing = sqRing;
+			else
+			{
+				cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+				if (cqRing == MAP_FAILED)
+				{
+					cqRing = nullptr;
+					return false;
+				}
+			}
+
+			sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+			void* sqesPtr = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+			if (sqesPtr == MAP_FAILED)
+				return false;
+			sqes = static_cast<io_uring_sqe*>(sqesPtr);
+
+			uint8_t* sq = static_cast<uint8_t*>(sqRing);
+			sqHead = (unsigned*)(sq + params.sq_off.head);
+			sqTail = (unsigned*)(sq + params.sq_off.tail);
+			sqMask = *(unsigned*)(sq + params.sq_off.ring_mask);
+			sqArray = (unsigned*)(sq + params.sq_off.array);
+			sqEntries = params.sq_entries;
+
+			uint8_t* cq = static_cast<uint8_t*>(cqRing);
+			cqHead = (unsigned*)(cq + params.cq_off.head);
+			cqTail = (unsigned*)(cq + params.cq_off.tail);
+			cqMask = *(unsigned*)(cq + params.cq_off.ring_mask);
+			cqes = (io_uring_cqe*)(cq + params.cq_off.cqes);
+			cqEntries = params.cq_entries;
+
+			return true;
+		}
+
+		bool Open(Operation* operation)
+		{
+			operation->fd = OpenNativeFile(operation->request.path);
+			if (operation->fd < 0)
+			{
+				operation->result.status = IOStatus::FileNotFound;
+				return false;
+			}
+
+			uint64_t fileSize = 0;
+			if (!GetNativeFileSize(operation->fd, fileSize))
+			{
+				operation->result.status = IOStatus::ReadError;
+				return false;
+			}
+
+			operation->destination = PrepareDestination(operation->request, operation->result, fileSize, operation->size);
+			operation->result.status = IOStatus::Success;
+
+			//Empty reads complete without touching the ring.
+			return operation->size != 0;
+		}
+
+		/// @brief Moves as much of the backlog into the submission queue as the rings allow. submitMutex must be held.
+		void FlushBacklog()
+		{
+			unsigned toSubmit = 0;
+			while (!backlog.empty() && submittedEntries < cqEntries)
+			{
+				unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+				unsigned tail = *sqTail;
+				if (tail - head >= sqEntries)
+					break;
+
+				Operation* operation = backlog.front();
+				backlog.pop_front();
+
+				unsigned index = tail & sqMask;
+				io_uring_sqe* sqe = &sqes[index];
+				memset(sqe, 0, sizeof(io_uring_sqe));
+
+				if (operation)
+				{
+					uint64_t remaining = operation->size - operation->result.bytesRead;
+					sqe->opcode = IORING_OP_READ;
+					sqe->fd = operation->fd;
+					sqe->addr = (uint64_t)(uintptr_t)(operation->destination + operation->result.bytesRead);
+					sqe->len = (uint32_t)(remaining < MAX_READ_CHUNK ? remaining : MAX_READ_CHUNK);
+					sqe->off = operation->request.offset + operation->result.bytesRead;
+				}
+				else
+					sqe->opcode = IORING_OP_NOP;
+
+				sqe->user_data = (uint64_t)(uintptr_t)operation;
+				sqArray[index] = index;
+
+				__atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+				submittedEntries++;
+				toSubmit++;
+			}
+
+			while (toSubmit > 0)
+			{
+				int submitted = (int)syscall(__NR_io_uring_enter, ringFd, toSubmit, 0, 0, nullptr, 0);
+				if (submitted < 0)
+				{
+					if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+						continue;
+					break;
+				}
+				toSubmit -= (unsigned)submitted;
+			}
+		}
+
+		void CompletionMain()
+		{
+			IAONNIS_PROFILE_THREAD("IO Completion");
+
+			while (running || activeOperations.load(std::memory_order_acquire) > 0)
+			{
+				int waited = (int)syscall(__NR_io_uring_enter, ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+				if (waited < 0 && errno != EINTR)
+				{
+					IAONNIS_LOG_ERROR("io_uring wait failed, failing outstanding reads. (errno = %d)", errno);
+					FailOutstanding();
+					break;
+				}
+
+				std::vector<Operation*> finished;
+				{
+					std::lock_guard<std::mutex> lock(submitMutex);
+
+					unsigned head = *cqHead;
+					unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+					while (head != tail)
+					{
+						io_uring_cqe* cqe = &cqes[head & cqMask];
+						Operation* operation = (Operation*)(uintptr_t)cqe->user_data;
+						int32_t res = cqe->res;
+						head++;
+						submittedEntries--;
+
+						if (!operation)
+							continue;
+
+						if (res < 0)
+						{
+							operation->result.status = IOStatus::ReadError;
+							finished.push_back(operation);
+						}
+						else
+						{
+							operation->result.bytesRead += (uint64_t)res;
+
+							//Short reads are resubmitted for the rest, a zero length read means end of file.
+							if (res == 0 || operation->result.bytesRead >= operation->size)
+								finished.push_back(operation);
+							else
+								backlog.push_back(operation);
+						}
+					}
+					__atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+					for (Operation* operation : finished)
+						inFlight.erase(operation);
+
+					FlushBacklog();
+				}
+
+				for (Operation* operation : finished)
+					Complete(operation);
+			}
+		}
+
+		/// @brief Completes every queued or submitted read with ReadError so no batch or awaiting caller waits forever.
+		/// The ring is not used again, later submissions fail straight away.
+		void FailOutstanding()
+		{
+			std::vector<Operation*> finished;
+			{
+				std::lock_guard<std::mutex> lock(submitMutex);
+				failed = true;
+				backlog.clear();
+
+				finished.assign(inFlight.begin(), inFlight.end());
+				inFlight.clear();
+			}
+
+			for (Operation* operation : finished)
+			{
+				operation->result.status = IOStatus::ReadError;
+				Complete(operation);
+			}
+		}
+
+		void Complete(Operation* operation)
+		{
+			if (operation->fd >= 0)
+				close(operation->fd);
+
+			if (!operation->request.destination)
+				operation->result.buffer.resize(operation->result.bytesRead);
+
+			if (operation->request.callback)
+				operation->request.callback(operation->result);
+
+			delete operation;
+			activeOperations.fetch_sub(1, std::memory_order_release);
+		}
+
+	private:
+		int ringFd = -1;
+
+		void* sqRing = nullptr;
+		size_t sqRingSize = 0;
+		void* cqRing = nullptr;
+		size_t cqRingSize = 0;
+		io_uring_sqe* sqes = nullptr;
+		size_t sqesSize = 0;
+
+		unsigned* sqHead = nullptr;
+		unsigned* sqTail = nullptr;
+		unsigned* sqArray = nullptr;
+		unsigned sqMask = 0;
+		unsigned sqEntries = 0;
+
+		unsigned* cqHead = nullptr;
+		unsigned* cqTail = nullptr;
+		io_uring_cqe* cqes = nullptr;
+		unsigned cqMask = 0;
+		unsigned cqEntries = 0;
+
+		std::mutex submitMutex;
+		std::deque<Operation*> backlog; //nullptr entries are NOPs
+		unsigned submittedEntries = 0;
+
+		//Reads handed to the ring or its backlog that have not completed yet.
+		std::unordered_set<Operation*> inFlight;
+		bool failed = false;
+
+		std::atomic<uint32_t> activeOperations{ 0 };
+		std::atomic<bool> running{ true };
+		std::thread completionThread;
+	};
+#endif
+
+	//=====================================IOService==============================================
+
+	void IOService::Initialize(uint32_t threadCount)
+	{
+		if (backend)
+			return;
+
+#if defined(__linux__)
+		backend = IoUringBackend::Create(256);
+#endif
+		if (!backend)
+			backend = std::make_unique<ThreadPoolIOBackend>(threadCount == 0 ? 1 : threadCount);
+
+		IAONNIS_LOG_INFO("IO Service initialized. (Backend = %s)", backend->GetName());
+	}
+
+	void IOService::Shutdown()
+	{
+		if (!backend)
+			return;
+
+		backend.reset();
+		IAONNIS_LOG_INFO("IO Service has shutdown");
+	}
+
+	void IOService::Submit(std::vector<IORequest>& requests)
+	{
+		if (backend)
+		{
+			backend->Submit(requests);
+			return;
+		}
+
+		for (auto& request : requests)
+		{
+			IOResult result;
+			ReadBlocking(request, result);
+			if (request.callback)
+				request.callback(result);
+		}
+	}
+
+	void IOService::Submit(IORequest request)
+	{
+		std::vector<IORequest> requests;
+		requests.push_back(std::move(request));
+		Submit(requests);
+	}
+
+	std::future<IOResult> IOService::ReadAsync(const filespace::filepath& path, uint64_t offset, uint64_t size, void* destination)
+	{
+		auto promise = std::make_shared<std::promise<IOResult>>();
+		std::future<IOResult> future = promise->get_future();
+
+		IORequest request;
+		request.path = path;
+		request.offset = offset;
+		request.size = size;
+		request.destination = destination;
+		request.callback = [promise](IOResult& result) { promise->set_value(std::move(result)); };
+
+		Submit(std::move(request));
+		return future;
+	}
+
+	std::vector<IOResult> IOService::ReadFiles(const std::vector<filespace::filepath>& paths)
+	{
+		std::vector<std::future<IOResult>> futures;
+		std::vector<IORequest> requests(paths.size());
+
+		for (size_t i = 0; i < paths.size(); i++)
+		{
+			auto promise = std::make_shared<std::promise<IOResult>>();
+			futures.push_back(promise->get_future());
+
+			requests[i].path = paths[i];
+			requests[i].callback = [promise](IOResult& result) { promise->set_value(std::move(result)); };
+		}
+
+		Submit(requests);
+
+		std::vector<IOResult> results;
+		results.reserve(paths.size());
+		for (auto& future : futures)
+			results.push_back(future.get());
+
+		return results;
+	}
+
+	IOResult IOService::ReadFile(const filespace::filepath& path)
+	{
+		return ReadAsync(path).get();
+	}
+
+	bool IOService::ReadTextFile(const filespace::filepath& path, std::string& text)
+	{
+		IOResult result = ReadFile(path);
+		if (!result.Succeeded())
+			return false;
+
+		text.assign(result.buffer.begin(), result.buffer.end());
+		return true;
+	}
+}
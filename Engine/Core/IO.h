@@ -0,0 +1,85 @@
+#pragma once
+#include "pch.h"
+#include "Utils.h"
+
+#include <future>
+#include <condition_variable>
+#include <deque>
+
+namespace Iaonnis {
+
+	enum class IOStatus
+	{
+		Pending,
+		Success,
+		FileNotFound,
+		ReadError,
+	};
+
+	struct IOResult
+	{
+		IOStatus status = IOStatus::Pending;
+		uint64_t bytesRead = 0;
+
+		/// @brief Holds the file contents when the request did not provide its own destination.
+		std::vector<uint8_t> buffer;
+
+		bool Succeeded()const { return status == IOStatus::Success; }
+	};
+
+	using IOCallback = std::function<void(IOResult& result)>;
+
+	struct IORequest
+	{
+		filespace::filepath path;
+		uint64_t offset = 0;
+
+		/// @brief Bytes to read. 0 reads from offset to the end of the file.
+		uint64_t size = 0;
+
+		/// @brief Must hold at least size bytes. If null the data is returned in IOResult::buffer.
+		void* destination = nullptr;
+
+		/// @brief Invoked on an I/O thread once the request completes.
+		IOCallback callback;
+	};
+
+	/// @brief Completes read requests in the background.
+	/// Linux uses io_uring when the kernel allows it, every other platform (or a refused ring) uses a pool of
+	/// threads doing positional reads.
+	class IOBackend
+	{
+	public:
+		virtual ~IOBackend() = default;
+		virtual void Submit(std::vector<IORequest>& requests) = 0;
+		virtual const char* GetName()const = 0;
+	};
+
+	class IOService
+	{
+	public:
+		static void Initialize(uint32_t threadCount = 4);
+		static void Shutdown();
+
+		/// @brief Queues every request at once so the device sees the whole batch. Callbacks run on I/O threads.
+		static void Submit(std::vector<IORequest>& requests);
+		static void Submit(IORequest request);
+
+		static std::future<IOResult> ReadAsync(const filespace::filepath& path, uint64_t offset = 0, uint64_t size = 0, void* destination = nullptr);
+
+		/// @brief Reads whole files as one batch and blocks until all of them completed. Results match the order of paths.
+		static std::vector<IOResult> ReadFiles(const std::vector<filespace::filepath>& paths);
+
+		/// @brief Reads a whole file and blocks until it completed.
+		static IOResult ReadFile(const filespace::filepath& path);
+		static bool ReadTextFile(const filespace::filepath& path, std::string& text);
+
+		static bool IsInitialized() { return backend != nullptr; }
+
+		/// @brief Synchronous positional read used by the thread pool and when the service is not running.
+		static void ReadBlocking(IORequest& request, IOResult& result);
+
+	private:
+		static std::unique_ptr<IOBackend> backend;
+	};
+}
@@ -0,0 +1,336 @@
+#include "InputRecorder.h"
+#include "Log.h"
+#include "IO.h"
+#include "FrameStats.h"
+
+#include <fstream>
+
+namespace Iaonnis {
+
+	namespace {
+
+		constexpr uint32_t InputRecordingMagic = 0x52494149; //"IAIR"
+		constexpr uint32_t InputRecordingVersion = 1;
+
+		struct InputRecordingHeader
+		{
+			uint32_t magic = InputRecordingMagic;
+			uint32_t version = InputRecordingVersion;
+			uint32_t frameCount = 0;
+			uint32_t recordCount = 0;
+		};
+
+		enum class RecorderMode
+		{
+			Idle,
+			Recording,
+			Replaying
+		};
+
+		struct InputRecorderData
+		{
+			RecorderMode mode = RecorderMode::Idle;
+			filespace::filepath path;
+
+			std::vector<InputFrame> frames;
+			std::vector<InputRecord> records;
+
+			//Frame opened by the next BeginFrame().
+			uint32_t frame = 0;
+
+			std::vector<float> replayFrameTimes;
+			EventListenerHandle listeners[4];
+		};
+
+		InputRecorderData& GetData()
+		{
+			static InputRecorderData data;
+			return data;
+		}
+
+		void AddRecord(const InputRecord& record)
+		{
+			GetData().records.push_back(record);
+		}
+
+		void OnKeyPress(KeyPressEvent& event)
+		{
+			InputRecord record;
+			record.eventType = event.eventType;
+			record.values[0] = event.keyCode;
+			record.values[1] = event.scanCode;
+			record.values[2] = event.action;
+			record.values[3] = event.mods;
+			AddRecord(record);
+		}
+
+		void OnMouseMove(MouseMoveEvent& event)
+		{
+			InputRecord record;
+			record.eventType = event.eventType;
+			record.vectors[0] = event.position;
+			record.vectors[1] = event.delta;
+			AddRecord(record);
+		}
+
+		void OnMouseClick(MouseClickedEvent& event)
+		{
+			InputRecord record;
+			record.eventType = event.eventType;
+			record.values[0] = event.button;
+			record.values[1] = event.action;
+			record.values[2] = event.mods;
+			AddRecord(record);
+		}
+
+		void OnMouseScroll(MouseScrollEvent& event)
+		{
+			InputRecord record;
+			record.eventType = event.eventType;
+			record.vectors[0] = event.offset;
+			AddRecord(record);
+		}
+
+		void Publish(const InputRecord& record)
+		{
+			switch (record.eventType)
+			{
+			case EventType::KEY_PRESS_EVENT:
+			{
+				KeyPressEvent event;
+				event.keyCode = record.values[0];
+				event.scanCode = record.values[1];
+				event.action = record.values[2];
+				event.mods = record.values[3];
+				EventBus::publish(event);
+				break;
+			}
+			case EventType::MOUSE_MOVE_EVENT:
+			{
+				MouseMoveEvent event;
+				event.position = record.vectors[0];
+				event.delta = record.vectors[1];
+				EventBus::publish(event);
+				break;
+			}
+			case EventType::MOUSE_CLICKED_EVENT:
+			{
+				MouseClickedEvent event;
+				event.button = record.values[0];
+				event.action = record.values[1];
+				event.mods = record.values[2];
+				EventBus::publish(event);
+				break;
+			}
+			case EventType::MOUSE_SCROLLED_EVENT:
+			{
+				MouseScrollEvent event;
+				event.offset = record.vectors[0];
+				EventBus::publish(event);
+				break;
+			}
+			default:
+				break;
+			}
+		}
+
+		void LogComparison(const InputRecorderData& data)
+		{
+			std::vector<float> recorded;
+			for (size_t i = 0; i < data.replayFrameTimes.size(); i++)
+				recorded.push_back((float)data.frames[i].frameTimeMs);
+
+			std::vector<float> replayed = data.replayFrameTimes;
+
+			IAONNIS_LOG_INFO("Input replay frame times over %u frames. Recorded: p50 %.3f p95 %.3f p99 %.3f ms, Replayed: p50 %.3f p95 %.3f p99 %.3f ms",
+				(uint32_t)replayed.size(),
+				FrameStats::Percentile(recorded, 0.50), FrameStats::Percentile(recorded, 0.95), FrameStats::Percentile(recorded, 0.99),
+				FrameStats::Percentile(replayed, 0.50), FrameStats::Percentile(replayed, 0.95), FrameStats::Percentile(replayed, 0.99));
+		}
+	}
+
+	bool InputRecorder::BeginRecording(const filespace::filepath& path)
+	{
+		InputRecorderData& data = GetData();
+		if (data.mode != RecorderMode::Idle)
+		{
+			IAONNIS_LOG_WARN("Input recorder is busy. (Path = %s)", path.string().c_str());
+			return false;
+		}
+
+		data.mode = RecorderMode::Recording;
+		data.path = path;
+		data.frames.clear();
+		data.records.clear();
+		data.frame = 0;
+
+		data.listeners[0] = EventBus::subscribe<KeyPressEvent, &OnKeyPress>();
+		data.listeners[1] = EventBus::subscribe<MouseMoveEvent, &OnMouseMove>();
+		data.listeners[2] = EventBus::subscribe<MouseClickedEvent, &OnMouseClick>();
+		data.listeners[3] = EventBus::subscribe<MouseScrollEvent, &OnMouseScroll>();
+
+		IAONNIS_LOG_INFO("Recording input. (Path = %s)", path.string().c_str());
+		return true;
+	}
+
+	bool InputRecorder::EndRecording()
+	{
+		InputRecorderData& data = GetData();
+		if (data.mode != RecorderMode::Recording)
+			return false;
+
+		for (EventListenerHandle& listener : data.listeners)
+			EventBus::unsubscribe(listener);
+
+		data.mode = RecorderMode::Idle;
+
+		//A frame that was opened but never closed is not part of the recording.
+		if (data.frames.size() > data.frame)
+		{
+			data.records.resize(data.frames.back().firstRecord);
+			data.frames.pop_back();
+		}
+
+		std::ofstream file(data.path, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			IAONNIS_LOG_ERROR("Failed to write input recording. (Path = %s)", data.path.string().c_str());
+			return false;
+		}
+
+		InputRecordingHeader header;
+		header.frameCount = (uint32_t)data.frames.size();
+		header.recordCount = (uint32_t)data.records.size();
+
+		file.write((const char*)&header, sizeof(header));
+		file.write((const char*)data.frames.data(), data.frames.size() * sizeof(InputFrame));
+		file.write((const char*)data.records.data(), data.records.size() * sizeof(InputRecord));
+
+		IAONNIS_LOG_INFO("Input recording written. (Path = %s, Frames = %u, Events = %u)", data.path.string().c_str(), header.frameCount, header.recordCount);
+		return true;
+	}
+
+	bool InputRecorder::IsRecording()
+	{
+		return GetData().mode == RecorderMode::Recording;
+	}
+
+	bool InputRecorder::BeginReplay(const filespace::filepath& path)
+	{
+		InputRecorderData& data = GetData();
+		if (data.mode != RecorderMode::Idle)
+		{
+			IAONNIS_LOG_WARN("Input recorder is busy. (Path = %s)", path.string().c_str());
+			return false;
+		}
+
+		IOResult file = IOService::ReadFile(path);
+		if (!file.Succeeded() || file.buffer.size() < sizeof(InputRecordingHeader))
+		{
+			IAONNIS_LOG_ERROR("Failed to read input recording. (Path = %s)", path.string().c_str());
+			return false;
+		}
+
+		InputRecordingHeader header;
+		memcpy(&header, file.buffer.data(), sizeof(header));
+
+		size_t framesSize = (size_t)header.frameCount * sizeof(InputFrame);
+		size_t recordsSize = (size_t)header.recordCount * sizeof(InputRecord);
+		if (header.magic != InputRecordingMagic || header.version != InputRecordingVersion
+			|| file.buffer.size() != sizeof(header) + framesSize + recordsSize)
+		{
+			IAONNIS_LOG_ERROR("Invalid input recording. (Path = %s)", path.string().c_str());
+			return false;
+		}
+
+		data.frames.resize(header.frameCount);
+		data.records.resize(header.recordCount);
+		memcpy(data.frames.data(), file.buffer.data() + sizeof(header), framesSize);
+		memcpy(data.records.data(), file.buffer.data() + sizeof(header) + framesSize, recordsSize);
+
+		data.mode = RecorderMode::Replaying;
+		data.path = path;
+		data.frame = 0;
+		data.replayFrameTimes.clear();
+		data.replayFrameTimes.reserve(header.frameCount);
+
+		IAONNIS_LOG_INFO("Replaying input. (Path = %s, Frames = %u)", path.string().c_str(), header.frameCount);
+		return true;
+	}
+
+	void InputRecorder::EndReplay()
+	{
+		InputRecorderData& data = GetData();
+		if (data.mode != RecorderMode::Replaying)
+			return;
+
+		LogComparison(data);
+		data.mode = RecorderMode::Idle;
+	}
+
+	bool InputRecorder::IsReplaying()
+	{
+		return GetData().mode == RecorderMode::Replaying;
+	}
+
+	bool InputRecorder::BeginFrame(uint32_t& state)
+	{
+		InputRecorderData& data = GetData();
+
+		if (data.mode == RecorderMode::Recording)
+		{
+			//Events dispatched between two frames belong to the one that follows.
+			InputFrame& frame = data.frames.emplace_back();
+			frame.state = state;
+			frame.firstRecord = data.frame > 0 ? data.frames[data.frame - 1].firstRecord + data.frames[data.frame - 1].recordCount : 0;
+		}
+		else if (data.mode == RecorderMode::Replaying)
+		{
+			if (data.frame >= data.frames.size())
+				return false;
+
+			state = data.frames[data.frame].state;
+		}
+
+		return true;
+	}
+
+	void InputRecorder::ReplayFrameEvents()
+	{
+		InputRecorderData& data = GetData();
+		if (data.mode != RecorderMode::Replaying || data.frame >= data.frames.size())
+			return;
+
+		const InputFrame& frame = data.frames[data.frame];
+		for (uint32_t i = 0; i < frame.recordCount; i++)
+			Publish(data.records[frame.firstRecord + i]);
+	}
+
+	void InputRecorder::EndFrame(double frameTimeMs)
+	{
+		InputRecorderData& data = GetData();
+
+		if (data.mode == RecorderMode::Recording && data.frame < data.frames.size())
+		{
+			InputFrame& frame = data.frames[data.frame];
+			frame.frameTimeMs = frameTimeMs;
+			frame.recordCount = (uint32_t)data.records.size() - frame.firstRecord;
+			data.frame++;
+		}
+		else if (data.mode == RecorderMode::Replaying && data.frame < data.frames.size())
+		{
+			data.replayFrameTimes.push_back((float)frameTimeMs);
+			data.frame++;
+		}
+	}
+
+	uint32_t InputRecorder::GetFrameIndex()
+	{
+		return GetData().frame;
+	}
+
+	uint32_t InputRecorder::GetFrameCount()
+	{
+		return (uint32_t)GetData().frames.size();
+	}
+}
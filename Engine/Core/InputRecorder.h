@@ -0,0 +1,70 @@
+#pragma once
+#include "pch.h"
+#include "Utils.h"
+#include "Event.h"
+
+namespace Iaonnis {
+
+	/// @brief One input event as stored in a recording. Fields not used by eventType are 0.
+	struct InputRecord
+	{
+		EventType eventType = EventType::Count;
+
+		/// @brief Key: key code, scan code, action, mods. Click: button, action, mods.
+		int32_t values[4] = {};
+
+		/// @brief Move: position, delta. Scroll: offset.
+		glm::vec2 vectors[2] = {};
+	};
+
+	/// @brief Frame of a recording: the input dispatched during it and how long it took when it was recorded.
+	struct InputFrame
+	{
+		double frameTimeMs = 0.0;
+
+		/// @brief Application state the input handlers depend on, restored before the frame's events are replayed.
+		uint32_t state = 0;
+
+		uint32_t firstRecord = 0;
+		uint32_t recordCount = 0;
+
+		//Frames are written to disk as raw bytes, this fills what would otherwise be uninitialized tail padding.
+		uint32_t reserved = 0;
+	};
+
+	/// <summary>
+	/// Records the key, mouse and scroll events published through EventBus, frame by frame, and replays them so two builds
+	/// render the exact same sequence of views. While replaying the application must ignore live input; the replayed
+	/// events are published by ReplayFrameEvents() in their recorded order, once per frame, regardless of how long the
+	/// frame took. When the replay ends the recorded and replayed frame times are logged side by side.
+	/// Only input that goes through EventBus is recorded; ImGui reads GLFW directly, so clicks and edits in the editor
+	/// panels during a recorded run are not replayed.
+	/// Main thread only.
+	/// </summary>
+	class InputRecorder
+	{
+	public:
+		static bool BeginRecording(const filespace::filepath& path);
+
+		/// @brief Writes the recording to the path given to BeginRecording().
+		static bool EndRecording();
+		static bool IsRecording();
+
+		static bool BeginReplay(const filespace::filepath& path);
+		static void EndReplay();
+		static bool IsReplaying();
+
+		/// @brief Opens the next frame. Recording stores state with it, replaying overwrites state with the recorded one.
+		/// Returns false once a replay has run out of frames.
+		static bool BeginFrame(uint32_t& state);
+
+		/// @brief Publishes the events of the frame opened by BeginFrame(). Does nothing unless replaying.
+		static void ReplayFrameEvents();
+
+		/// @brief Closes the frame opened by BeginFrame().
+		static void EndFrame(double frameTimeMs);
+
+		static uint32_t GetFrameIndex();
+		static uint32_t GetFrameCount();
+	};
+}
@@ -0,0 +1,408 @@
+#include "Job.h"
+#include "Log.h"
+#include "Defines.h"
+#include "Profiler.h"
+
+namespace Iaonnis {
+
+	//Jobs are recycled in a ring. A slot is only reused after IAONNIS_MAX_JOBS newer jobs were created,
+	//so a frame must never keep more than that many jobs in flight.
+	Job jobPool[IAONNIS_MAX_JOBS];
+	std::atomic<uint32_t> allocatedJobs{ 0 };
+
+	thread_local uint32_t tlsThreadIndex = ~0u;
+
+	std::vector<std::thread> JobSystem::workers;
+	std::vector<std::unique_ptr<WorkStealingQueue>> JobSystem::queues;
+
+	std::deque<Job*> JobSystem::externalQueue;
+	std::mutex JobSystem::externalQueueMutex;
+
+	std::mutex JobSystem::sleepMutex;
+	std::condition_variable JobSystem::sleepCondition;
+	std::atomic<uint32_t> JobSystem::sleepingWorkers{ 0 };
+	std::atomic<int32_t> JobSystem::queuedJobs{ 0 };
+
+	std::atomic<bool> JobSystem::running{ false };
+
+	//==================================WorkStealingQueue=========================================
+
+	bool WorkStealingQueue::Push(Job* job)
+	{
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_acquire);
+		if (b - t >= IAONNIS_JOB_QUEUE_CAPACITY)
+			return false;
+
+		jobs[b & MASK].store(job, std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_release);
+		return true;
+	}
+
+	Job* WorkStealingQueue::Pop()
+	{
+		int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+
+		if (t > b)
+		{
+			//Empty
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		Job* job = jobs[b & MASK].load(std::memory_order_relaxed);
+		if (t != b)
+			return job;
+
+		//Last job in the queue, race any thieves for it.
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			job = nullptr;
+
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return job;
+	}
+
+	Job* WorkStealingQueue::Steal()
+	{
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t b = bottom.load(std::memory_order_acquire);
+
+		if (t >= b)
+			return nullptr;
+
+		Job* job = jobs[t & MASK].load(std::memory_order_acquire);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr;
+
+		return job;
+	}
+
+	size_t WorkStealingQueue::Size() const
+	{
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_relaxed);
+		return b > t ? (size_t)(b - t) : 0;
+	}
+
+	//=====================================JobSystem==============================================
+
+	void JobSystem::Initialize(uint32_t workerCount)
+	{
+		if (running)
+			return;
+
+		if (workerCount == 0)
+		{
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		//Queue 0 belongs to the thread calling Initialize (the main thread).
+		queues.clear();
+		for (uint32_t i = 0; i < workerCount + 1; i++)
+			queues.emplace_back(std::make_unique<WorkStealingQueue>());
+
+		tlsThreadIndex = 0;
+		running = true;
+
+		for (uint32_t i = 0; i < workerCount; i++)
+			workers.emplace_back(WorkerMain, i + 1);
+
+		IAONNIS_LOG_INFO("Job System initialized with %d workers.", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		if (!running)
+			return;
+
+		running = false;
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+		}
+		sleepCondition.notify_all();
+
+		for (auto& worker : workers)
+			worker.join();
+		workers.clear();
+
+		//Anything still queued runs on the calling thread so no dependant is left waiting forever.
+		while (Job* job = GetJob())
+			Execute(job);
+
+		queues.clear();
+		IAONNIS_LOG_INFO("Job System has shutdown");
+	}
+
+	JobHandle JobSystem::CreateJob(JobFunction function, JobHandle parent, JobType type)
+	{
+		Job* job = AllocateJob();
+		job->function = std::move(function);
+		job->type = type;
+		job->parent = nullptr;
+
+		if (parent.IsValid() && !IsDone(parent))
+		{
+			job->parent = parent.job;
+			parent.job->unfinishedJobs.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		return { job, job->generation.load(std::memory_order_relaxed) };
+	}
+
+	void JobSystem::AddDependency(JobHandle job, JobHandle dependency)
+	{
+		if (!job.IsValid() || !dependency.IsValid())
+			return;
+
+		Job* prerequisite = dependency.job;
+		while (prerequisite->continuationLock.test_and_set(std::memory_order_acquire))
+			std::this_thread::yield();
+
+		if (!prerequisite->finished && prerequisite->generation.load(std::memory_order_relaxed) == dependency.generation)
+		{
+			IAONNIS_ASSERT(prerequisite->continuationCount < IAONNIS_MAX_JOB_CONTINUATIONS, "Too many jobs depend on a single job.");
+			prerequisite->continuations[prerequisite->continuationCount++] = job.job;
+			job.job->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		prerequisite->continuationLock.clear(std::memory_order_release);
+	}
+
+	void JobSystem::Run(JobHandle handle)
+	{
+		if (!handle.IsValid())
+			return;
+
+		if (handle.job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			Submit(handle.job);
+	}
+
+	JobHandle JobSystem::Schedule(JobFunction function, JobType type)
+	{
+		JobHandle handle = CreateJob(std::move(function), {}, type);
+		Run(handle);
+		return handle;
+	}
+
+	JobHandle JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, std::function<void(uint32_t begin, uint32_t end)> function, JobType type)
+	{
+		if (batchSize == 0)
+			batchSize = 1;
+
+		JobHandle root = CreateJob([]() {}, {}, type);
+
+		//The root outlives its batches, keeping the body there instead of in a shared_ptr leaves
+		//the batch closures small enough for std::function to store without touching the heap.
+		Job* rootJob = root.job;
+		rootJob->rangeFunction = std::move(function);
+		for (uint32_t begin = 0; begin < count; begin += batchSize)
+		{
+			uint32_t end = std::min(begin + batchSize, count);
+			JobHandle batch = CreateJob([rootJob, begin, end]() { rootJob->rangeFunction(begin, end); }, root, type);
+			Run(batch);
+		}
+
+		Run(root);
+		return root;
+	}
+
+	void JobSystem::Wait(JobHandle handle)
+	{
+		while (!IsDone(handle))
+		{
+			if (!RunPendingJob())
+				std::this_thread::yield();
+		}
+	}
+
+	bool JobSystem::RunPendingJob()
+	{
+		Job* job = GetJob();
+		if (!job)
+			return false;
+
+		Execute(job);
+		return true;
+	}
+
+	bool JobSystem::IsDone(JobHandle handle)
+	{
+		if (!handle.IsValid())
+			return true;
+
+		if (handle.job->generation.load(std::memory_order_acquire) != handle.generation)
+			return true;
+
+		return handle.job->unfinishedJobs.load(std::memory_order_acquire) == 0;
+	}
+
+	uint32_t JobSystem::GetThreadIndex()
+	{
+		return tlsThreadIndex;
+	}
+
+	Job* JobSystem::AllocateJob()
+	{
+		uint32_t index = allocatedJobs.fetch_add(1, std::memory_order_relaxed) & (IAONNIS_MAX_JOBS - 1);
+		Job* job = &jobPool[index];
+
+		//The ring has wrapped onto a job that is still in flight. Overwriting it would corrupt its parent counter and
+		//generation, so help drain the queues until it finishes. A job created but never Run() by this thread would
+		//never finish here, keep fewer than IAONNIS_MAX_JOBS jobs unsubmitted.
+		if (job->unfinishedJobs.load(std::memory_order_acquire) != 0)
+		{
+			static std::atomic_flag warned = ATOMIC_FLAG_INIT;
+			if (!warned.test_and_set(std::memory_order_relaxed))
+				IAONNIS_LOG_WARN("Job pool exhausted, allocations wait for jobs to finish. Too many jobs in flight.");
+
+			while (job->unfinishedJobs.load(std::memory_order_acquire) != 0)
+			{
+				if (!RunPendingJob())
+					std::this_thread::yield();
+			}
+		}
+
+		job->generation.fetch_add(1, std::memory_order_release);
+		job->parent = nullptr;
+		job->continuationCount = 0;
+		job->finished = false;
+		job->pendingDependencies.store(1, std::memory_order_relaxed);
+		job->unfinishedJobs.store(1, std::memory_order_release);
+
+		return job;
+	}
+
+	void JobSystem::Submit(Job* job)
+	{
+		if (!running)
+		{
+			Execute(job);
+			return;
+		}
+
+		uint32_t threadIndex = GetThreadIndex();
+		if (threadIndex >= queues.size() || !queues[threadIndex]->Push(job))
+		{
+			std::lock_guard<std::mutex> lock(externalQueueMutex);
+			externalQueue.push_back(job);
+		}
+
+		queuedJobs.fetch_add(1, std::memory_order_seq_cst);
+		WakeWorkers(1);
+	}
+
+	Job* JobSystem::GetJob()
+	{
+		uint32_t threadIndex = GetThreadIndex();
+		uint32_t queueCount = (uint32_t)queues.size();
+
+		Job* job = nullptr;
+		if (threadIndex < queueCount)
+			job = queues[threadIndex]->Pop();
+
+		if (!job)
+		{
+			uint32_t start = threadIndex < queueCount ? threadIndex + 1 : 0;
+			for (uint32_t i = 0; i < queueCount && !job; i++)
+			{
+				uint32_t victim = (start + i) % queueCount;
+				if (victim == threadIndex)
+					continue;
+				job = queues[victim]->Steal();
+			}
+		}
+
+		if (!job)
+		{
+			std::lock_guard<std::mutex> lock(externalQueueMutex);
+			if (!externalQueue.empty())
+			{
+				job = externalQueue.front();
+				externalQueue.pop_front();
+			}
+		}
+
+		if (job)
+			queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+		return job;
+	}
+
+	void JobSystem::Execute(Job* job)
+	{
+		if (job->function)
+		{
+			IAONNIS_PROFILE_SCOPE("Job");
+			job->function();
+			job->function = nullptr;
+		}
+
+		Finish(job);
+	}
+
+	void JobSystem::Finish(Job* job)
+	{
+		if (job->unfinishedJobs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+
+		Job* parent = job->parent;
+		job->rangeFunction = nullptr;
+
+		while (job->continuationLock.test_and_set(std::memory_order_acquire))
+			std::this_thread::yield();
+		job->finished = true;
+		uint32_t continuationCount = job->continuationCount;
+		job->continuationLock.clear(std::memory_order_release);
+
+		for (uint32_t i = 0; i < continuationCount; i++)
+		{
+			Job* continuation = job->continuations[i];
+			if (continuation->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				Submit(continuation);
+		}
+
+		if (parent)
+			Finish(parent);
+	}
+
+	void JobSystem::WorkerMain(uint32_t threadIndex)
+	{
+		tlsThreadIndex = threadIndex;
+		IAONNIS_PROFILE_THREAD("Worker " + std::to_string(threadIndex));
+
+		while (running)
+		{
+			Job* job = GetJob();
+			if (job)
+			{
+				Execute(job);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+			sleepCondition.wait(lock, []() { return queuedJobs.load(std::memory_order_seq_cst) > 0 || !running; });
+			sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+
+	void JobSystem::WakeWorkers(uint32_t count)
+	{
+		if (sleepingWorkers.load(std::memory_order_seq_cst) == 0)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+		}
+
+		if (count == 1)
+			sleepCondition.notify_one();
+		else
+			sleepCondition.notify_all();
+	}
+}
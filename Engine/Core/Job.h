@@ -1,8 +1,139 @@
 #pragma once
+#include "pch.h"
 
-enum class JobType
-{
-	
-};
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 
+namespace Iaonnis {
 
+#define IAONNIS_MAX_JOBS 8192
+#define IAONNIS_MAX_JOB_CONTINUATIONS 16
+#define IAONNIS_JOB_QUEUE_CAPACITY 4096
+
+	enum class JobType
+	{
+		General,
+		Resource,
+		Scene,
+		Renderer,
+	};
+
+	using JobFunction = std::function<void()>;
+
+	struct Job
+	{
+		JobFunction function;
+		JobType type = JobType::General;
+
+		/// @brief Body shared by the batches of a ParallelFor, stored on its root job. Cleared once every batch has finished.
+		std::function<void(uint32_t begin, uint32_t end)> rangeFunction;
+
+		Job* parent = nullptr;
+
+		/// @brief 1 for the job itself plus 1 for every unfinished child.
+		std::atomic<int32_t> unfinishedJobs{ 0 };
+
+		/// @brief Prerequisites that have not finished yet plus 1 until the job is Run().
+		std::atomic<int32_t> pendingDependencies{ 0 };
+
+		/// @brief Jobs that become runnable once this one finishes.
+		Job* continuations[IAONNIS_MAX_JOB_CONTINUATIONS];
+		uint32_t continuationCount = 0;
+		std::atomic_flag continuationLock = ATOMIC_FLAG_INIT;
+		bool finished = false;
+
+		std::atomic<uint32_t> generation{ 0 };
+	};
+
+	/// @brief Lightweight reference to a pooled job.
+	/// A handle whose generation no longer matches the pooled job refers to a job that has already finished.
+	struct JobHandle
+	{
+		Job* job = nullptr;
+		uint32_t generation = 0;
+
+		bool IsValid()const { return job != nullptr; }
+	};
+
+	/// @brief Chase-Lev deque. Only the owning thread may Push/Pop, any thread may Steal.
+	class WorkStealingQueue
+	{
+	public:
+		bool Push(Job* job);
+		Job* Pop();
+		Job* Steal();
+
+		size_t Size()const;
+
+	private:
+		static const int64_t MASK = IAONNIS_JOB_QUEUE_CAPACITY - 1;
+
+		std::atomic<int64_t> top{ 0 };
+		std::atomic<int64_t> bottom{ 0 };
+		std::atomic<Job*> jobs[IAONNIS_JOB_QUEUE_CAPACITY];
+	};
+
+	class JobSystem
+	{
+	public:
+		/// @brief Spawns the worker pool. workerCount = 0 uses one worker per hardware thread minus the calling thread.
+		static void Initialize(uint32_t workerCount = 0);
+		static void Shutdown();
+
+		/// @brief Creates a job that will not start until Run() is called and every dependency has finished.
+		/// If parent is valid the parent is not considered done until this job finishes too.
+		static JobHandle CreateJob(JobFunction function, JobHandle parent = {}, JobType type = JobType::General);
+
+		/// @brief job will not start before dependency has finished. Must be called before Run(job).
+		static void AddDependency(JobHandle job, JobHandle dependency);
+
+		static void Run(JobHandle handle);
+
+		/// @brief CreateJob + Run.
+		static JobHandle Schedule(JobFunction function, JobType type = JobType::General);
+
+		/// @brief Splits [0, count) into batches of batchSize and runs function(begin, end) for each batch.
+		/// The returned handle finishes when every batch has finished.
+		static JobHandle ParallelFor(uint32_t count, uint32_t batchSize, std::function<void(uint32_t begin, uint32_t end)> function, JobType type = JobType::General);
+
+		/// @brief Blocks until the job has finished. The waiting thread runs other jobs in the meantime.
+		static void Wait(JobHandle handle);
+		static bool IsDone(JobHandle handle);
+
+		/// @brief Executes one queued job on the calling thread. Returns false if there was nothing to run.
+		static bool RunPendingJob();
+
+		static uint32_t GetWorkerCount() { return (uint32_t)workers.size(); }
+
+		/// @brief 0 for the thread that called Initialize, 1..n for workers and ~0u for any other thread.
+		static uint32_t GetThreadIndex();
+
+		static bool IsInitialized() { return running; }
+
+	private:
+		static Job* AllocateJob();
+		static void Submit(Job* job);
+		static Job* GetJob();
+		static void Execute(Job* job);
+		static void Finish(Job* job);
+
+		static void WorkerMain(uint32_t threadIndex);
+		static void WakeWorkers(uint32_t count);
+
+	private:
+		static std::vector<std::thread> workers;
+		static std::vector<std::unique_ptr<WorkStealingQueue>> queues;
+
+		/// @brief Jobs submitted from threads that do not own a queue.
+		static std::deque<Job*> externalQueue;
+		static std::mutex externalQueueMutex;
+
+		static std::mutex sleepMutex;
+		static std::condition_variable sleepCondition;
+		static std::atomic<uint32_t> sleepingWorkers;
+		static std::atomic<int32_t> queuedJobs;
+
+		static std::atomic<bool> running;
+	};
+}
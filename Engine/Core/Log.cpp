@@ -1,12 +1,520 @@
 #include "log.h"
+#include "Profiler.h"
+#include "Memory.h"
+
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <thread>
 
 namespace Iaonnis {
 
+	static_assert((IAONNIS_LOG_RING_CAPACITY & (IAONNIS_LOG_RING_CAPACITY - 1)) == 0, "Log ring capacity must be a power of two.");
+
+	//Lines kept for DispatchEvents(). If nobody dispatches, newer lines are not queued for the editor.
+#define IAONNIS_LOG_MAX_PENDING_EVENTS 1024
+
 	Log s_log;
 
+	namespace {
+
+		/// Bounded MPSC queue (Vyukov). sequence == position: free for the producer claiming position,
+		/// sequence == position + 1: committed and ready for the logging thread.
+		struct Slot
+		{
+			std::atomic<uint64_t> sequence{ 0 };
+			LogRecord record;
+		};
+
+		struct LogData
+		{
+			Slot slots[IAONNIS_LOG_RING_CAPACITY];
+			std::atomic<uint64_t> enqueuePosition{ 0 };
+			uint64_t dequeuePosition = 0;
+
+			//Bumped after every commit, the logging thread sleeps on it.
+			std::atomic<uint32_t> published{ 0 };
+			std::atomic<uint64_t> written{ 0 };
+			std::atomic<uint64_t> dropped{ 0 };
+
+			std::atomic<bool> running{ false };
+			std::thread thread;
+
+			//Sinks. Only the logging thread touches them while it runs, the synchronous path holds sinkMutex.
+			std::mutex sinkMutex;
+			FILE* file = nullptr;
+
+			std::mutex eventMutex;
+			std::vector<std::string> pendingEvents;
+			std::vector<std::string> dispatchEvents;
+		};
+
+		LogData& GetData()
+		{
+			static LogData data;
+			return data;
+		}
+
+		//Used while the logging thread is not running.
+		thread_local LogRecord synchronousRecord;
+
+		template <typename T>
+		T ReadValue(const uint8_t* data)
+		{
+			T value;
+			std::memcpy(&value, data, sizeof(T));
+			return value;
+		}
+
+		struct ArgumentReader
+		{
+			const LogRecord& record;
+			size_t offset = 0;
+
+			bool Next(LogArgumentType& type, uint64_t& bits, const char*& text, size_t& length)
+			{
+				if (offset >= record.argumentBytes)
+					return false;
+
+				type = (LogArgumentType)record.arguments[offset++];
+				if (type == LogArgumentType::String)
+				{
+					length = ReadValue<uint16_t>(record.arguments + offset);
+					text = (const char*)record.arguments + offset + sizeof(uint16_t);
+					offset += sizeof(uint16_t) + length;
+				}
+				else
+				{
+					bits = ReadValue<uint64_t>(record.arguments + offset);
+					offset += sizeof(uint64_t);
+				}
+				return true;
+			}
+		};
+
+		int64_t AsInt(LogArgumentType type, uint64_t bits)
+		{
+			if (type == LogArgumentType::Double)
+			{
+				double value;
+				std::memcpy(&value, &bits, sizeof(double));
+				return (int64_t)value;
+			}
+			return (int64_t)bits;
+		}
+
+		double AsDouble(LogArgumentType type, uint64_t bits)
+		{
+			if (type == LogArgumentType::Double)
+			{
+				double value;
+				std::memcpy(&value, &bits, sizeof(double));
+				return value;
+			}
+			return type == LogArgumentType::Int ? (double)(int64_t)bits : (double)bits;
+		}
+
+		/// Replays a printf format against the serialized arguments one conversion at a time.
+		/// Length modifiers are ignored, integers are always printed from 64 bit values.
+		size_t FormatMessage(const LogRecord& record, char* out, size_t capacity)
+		{
+			ArgumentReader reader{ record };
+			size_t length = 0;
+			auto append = [&](int written)
+				{
+					if (written > 0)
+						length = std::min(length + (size_t)written, capacity - 1);
+				};
+
+			for (const char* c = record.format; *c && length < capacity - 1; c++)
+			{
+				if (*c != '%')
+				{
+					out[length++] = *c;
+					continue;
+				}
+
+				if (c[1] == '%')
+				{
+					out[length++] = '%';
+					c++;
+					continue;
+				}
+
+				//Copy flags, width and precision, drop the length modifier.
+				char spec[32] = "%";
+				size_t specLength = 1;
+				const char* p = c + 1;
+				int starValues[2];
+				int starCount = 0;
+				while (*p && std::strchr("-+ #0123456789.*", *p))
+				{
+					if (*p == '*' && starCount < 2)
+					{
+						LogArgumentType type; uint64_t bits = 0; const char* text; size_t textLength;
+						starValues[starCount++] = reader.Next(type, bits, text, textLength) ? (int)AsInt(type, bits) : 0;
+					}
+					if (specLength < sizeof(spec) - 4)
+						spec[specLength++] = *p;
+					p++;
+				}
+				while (*p && std::strchr("hlLqjzt", *p))
+					p++;
+
+				char conversion = *p;
+				if (!conversion)
+					break;
+				c = p;
+
+				LogArgumentType type = LogArgumentType::Int;
+				uint64_t bits = 0;
+				const char* text = nullptr;
+				size_t textLength = 0;
+				if (!reader.Next(type, bits, text, textLength))
+				{
+					append(std::snprintf(out + length, capacity - length, "<?>"));
+					continue;
+				}
+
+				char* target = out + length;
+				size_t room = capacity - length;
+				switch (conversion)
+				{
+					case 'd': case 'i':
+						spec[specLength++] = 'l'; spec[specLength++] = 'l'; spec[specLength++] = 'd'; spec[specLength] = 0;
+						append(starCount == 2 ? std::snprintf(target, room, spec, starValues[0], starValues[1], (long long)AsInt(type, bits))
+							: starCount == 1 ? std::snprintf(target, room, spec, starValues[0], (long long)AsInt(type, bits))
+							: std::snprintf(target, room, spec, (long long)AsInt(type, bits)));
+						break;
+					case 'u': case 'o': case 'x': case 'X':
+						spec[specLength++] = 'l'; spec[specLength++] = 'l'; spec[specLength++] = conversion; spec[specLength] = 0;
+						append(starCount == 2 ? std::snprintf(target, room, spec, starValues[0], starValues[1], (unsigned long long)AsInt(type, bits))
+							: starCount == 1 ? std::snprintf(target, room, spec, starValues[0], (unsigned long long)AsInt(type, bits))
+							: std::snprintf(target, room, spec, (unsigned long long)AsInt(type, bits)));
+						break;
+					case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+						spec[specLength++] = conversion; spec[specLength] = 0;
+						append(starCount == 2 ? std::snprintf(target, room, spec, starValues[0], starValues[1], AsDouble(type, bits))
+							: starCount == 1 ? std::snprintf(target, room, spec, starValues[0], AsDouble(type, bits))
+							: std::snprintf(target, room, spec, AsDouble(type, bits)));
+						break;
+					case 'c':
+						spec[specLength++] = 'c'; spec[specLength] = 0;
+						append(std::snprintf(target, room, spec, (int)AsInt(type, bits)));
+						break;
+					case 's':
+					{
+						if (type != LogArgumentType::String)
+						{
+							append(std::snprintf(target, room, "<?>"));
+							break;
+						}
+
+						char string[IAONNIS_LOG_ARGUMENT_BYTES];
+						std::memcpy(string, text, textLength);
+						string[textLength] = 0;
+
+						spec[specLength++] = 's'; spec[specLength] = 0;
+						append(starCount == 2 ? std::snprintf(target, room, spec, starValues[0], starValues[1], string)
+							: starCount == 1 ? std::snprintf(target, room, spec, starValues[0], string)
+							: std::snprintf(target, room, spec, string));
+						break;
+					}
+					case 'p':
+						append(std::snprintf(target, room, "0x%llx", (unsigned long long)bits));
+						break;
+					default:
+						append(std::snprintf(target, room, "<?>"));
+						break;
+				}
+			}
+
+			if (record.truncated && length + 4 < capacity)
+			{
+				std::memcpy(out + length, "...", 3);
+				length += 3;
+			}
+
+			out[length] = 0;
+			return length;
+		}
+
+		void WriteRecord(LogData& data, const LogRecord& record)
+		{
+			IAONNIS_MEMORY_TAG(MemoryTag::Log);
+
+			std::time_t seconds = (std::time_t)(record.time / 1000000000);
+			std::tm local_tm;
+#ifdef _WIN32
+			localtime_s(&local_tm, &seconds);
+#else
+			localtime_r(&seconds, &local_tm);
+#endif
+			char timestamp[32];
+			std::strftime(timestamp, sizeof(timestamp), "%I:%M %p", &local_tm);
+
+			char message[4096];
+			FormatMessage(record, message, sizeof(message));
+
+			char line[sizeof(message) + 512];
+			int length = std::snprintf(line, sizeof(line), "%s%s%s:%d %s\n", timestamp, Log::logger().kLogLevelStrings[record.level].data(),
+				record.file, record.line, message);
+			length = std::clamp(length, 0, (int)sizeof(line) - 1);
+
+			std::fwrite(line, 1, length, stdout);
+			if (data.file)
+				std::fwrite(line, 1, length, data.file);
+
+			std::lock_guard<std::mutex> lock(data.eventMutex);
+			if (data.pendingEvents.size() < IAONNIS_LOG_MAX_PENDING_EVENTS)
+				data.pendingEvents.emplace_back(line, length);
+		}
+
+		void FlushSinks(LogData& data)
+		{
+			std::fflush(stdout);
+			if (data.file)
+				std::fflush(data.file);
+		}
+
+		/// Writes every committed record in order. Returns false if nothing was ready.
+		bool Drain(LogData& data)
+		{
+			bool wroteAny = false;
+			while (true)
+			{
+				Slot& slot = data.slots[data.dequeuePosition & (IAONNIS_LOG_RING_CAPACITY - 1)];
+				if (slot.sequence.load(std::memory_order_acquire) != data.dequeuePosition + 1)
+					break;
+
+				WriteRecord(data, slot.record);
+				slot.sequence.store(data.dequeuePosition + IAONNIS_LOG_RING_CAPACITY, std::memory_order_release);
+				data.dequeuePosition++;
+				wroteAny = true;
+			}
+
+			if (wroteAny)
+			{
+				FlushSinks(data);
+				data.written.store(data.dequeuePosition, std::memory_order_release);
+			}
+			return wroteAny;
+		}
+
+		void LoggingThread()
+		{
+			IAONNIS_PROFILE_THREAD("Log");
+			LogData& data = GetData();
+
+			while (true)
+			{
+				uint32_t published = data.published.load(std::memory_order_acquire);
+				bool running = data.running.load(std::memory_order_acquire);
+
+				bool wroteAny;
+				{
+					std::lock_guard<std::mutex> lock(data.sinkMutex);
+					wroteAny = Drain(data);
+				}
+				if (wroteAny)
+					continue;
+				if (!running)
+					break;
+
+				//A record claimed before the last commit may still be being written, give its producer a moment.
+				if (data.enqueuePosition.load(std::memory_order_acquire) != data.dequeuePosition)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				data.published.wait(published, std::memory_order_acquire);
+			}
+		}
+	}
+
+	namespace LogEncoding {
+
+		void WriteValue(LogRecord& record, LogArgumentType type, const void* value)
+		{
+			if (record.argumentBytes + 1 + sizeof(uint64_t) > IAONNIS_LOG_ARGUMENT_BYTES)
+			{
+				record.truncated = true;
+				return;
+			}
+
+			record.arguments[record.argumentBytes++] = (uint8_t)type;
+			std::memcpy(record.arguments + record.argumentBytes, value, sizeof(uint64_t));
+			record.argumentBytes += sizeof(uint64_t);
+		}
+
+		void WriteString(LogRecord& record, const char* text, size_t length)
+		{
+			size_t room = IAONNIS_LOG_ARGUMENT_BYTES - record.argumentBytes;
+			if (room < 1 + sizeof(uint16_t))
+			{
+				record.truncated = true;
+				return;
+			}
+
+			if (length > room - 1 - sizeof(uint16_t))
+			{
+				length = room - 1 - sizeof(uint16_t);
+				record.truncated = true;
+			}
+
+			uint16_t stored = (uint16_t)length;
+			record.arguments[record.argumentBytes++] = (uint8_t)LogArgumentType::String;
+			std::memcpy(record.arguments + record.argumentBytes, &stored, sizeof(uint16_t));
+			std::memcpy(record.arguments + record.argumentBytes + sizeof(uint16_t), text, length);
+			record.argumentBytes += (uint16_t)(sizeof(uint16_t) + length);
+		}
+	}
+
 	Log& Log::logger()
 	{
 		return s_log;
 	}
 
+	void Log::Initialize(const std::string& logFile)
+	{
+		LogData& data = GetData();
+		if (data.running)
+			return;
+
+		for (uint64_t i = 0; i < IAONNIS_LOG_RING_CAPACITY; i++)
+			data.slots[i].sequence.store(i, std::memory_order_relaxed);
+		data.enqueuePosition.store(0, std::memory_order_relaxed);
+		data.dequeuePosition = 0;
+		data.written.store(0, std::memory_order_relaxed);
+
+		if (!logFile.empty())
+		{
+#ifdef _WIN32
+			if (fopen_s(&data.file, logFile.c_str(), "w") != 0)
+				data.file = nullptr;
+#else
+			data.file = std::fopen(logFile.c_str(), "w");
+#endif
+		}
+
+		data.running.store(true, std::memory_order_release);
+		data.thread = std::thread(LoggingThread);
+
+		if (!logFile.empty() && !data.file)
+			IAONNIS_LOG_WARN("Failed to open the log file. (Path = %s)", logFile.c_str());
+	}
+
+	void Log::Shutdown()
+	{
+		LogData& data = GetData();
+		if (!data.running)
+			return;
+
+		data.running.store(false, std::memory_order_release);
+		data.published.fetch_add(1, std::memory_order_release);
+		data.published.notify_one();
+		data.thread.join();
+
+		std::lock_guard<std::mutex> lock(data.sinkMutex);
+		Drain(data);
+		if (data.file)
+		{
+			std::fclose(data.file);
+			data.file = nullptr;
+		}
+	}
+
+	void Log::Flush()
+	{
+		LogData& data = GetData();
+		uint64_t target = data.enqueuePosition.load(std::memory_order_acquire);
+		while (data.running.load(std::memory_order_acquire) && data.written.load(std::memory_order_acquire) < target)
+			std::this_thread::yield();
+	}
+
+	void Log::DispatchEvents()
+	{
+		LogData& data = GetData();
+		{
+			std::lock_guard<std::mutex> lock(data.eventMutex);
+			data.dispatchEvents.swap(data.pendingEvents);
+		}
+
+		for (const std::string& line : data.dispatchEvents)
+		{
+			LogEvent logEvent(line);
+			EventBus::publish(logEvent);
+		}
+		data.dispatchEvents.clear();
+	}
+
+	uint64_t Log::GetDroppedCount()
+	{
+		return GetData().dropped.load(std::memory_order_relaxed);
+	}
+
+	LogRecord* Log::BeginRecord(LogLevel level)
+	{
+		LogData& data = GetData();
+
+		LogRecord* record = &synchronousRecord;
+		if (data.running.load(std::memory_order_acquire))
+		{
+			record = nullptr;
+			uint64_t position = data.enqueuePosition.load(std::memory_order_relaxed);
+			while (!record)
+			{
+				Slot& slot = data.slots[position & (IAONNIS_LOG_RING_CAPACITY - 1)];
+				int64_t difference = (int64_t)slot.sequence.load(std::memory_order_acquire) - (int64_t)position;
+
+				if (difference == 0)
+				{
+					if (data.enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						record = &slot.record;
+				}
+				else if (difference < 0)
+				{
+					//Full. Losing an error is worse than stalling the caller.
+					if (level > LogLevel::ERROR)
+					{
+						data.dropped.fetch_add(1, std::memory_order_relaxed);
+						return nullptr;
+					}
+
+					std::this_thread::yield();
+					position = data.enqueuePosition.load(std::memory_order_relaxed);
+				}
+				else
+					position = data.enqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		record->level = (uint8_t)level;
+		record->truncated = false;
+		record->argumentBytes = 0;
+		record->time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		return record;
+	}
+
+	void Log::CommitRecord(LogRecord* record)
+	{
+		LogData& data = GetData();
+
+		if (record == &synchronousRecord)
+		{
+			std::lock_guard<std::mutex> lock(data.sinkMutex);
+			WriteRecord(data, *record);
+			FlushSinks(data);
+			return;
+		}
+
+		size_t index = (reinterpret_cast<uint8_t*>(record) - reinterpret_cast<uint8_t*>(&data.slots[0].record)) / sizeof(Slot);
+		Slot& slot = data.slots[index];
+		uint64_t position = slot.sequence.load(std::memory_order_relaxed);
+		slot.sequence.store(position + 1, std::memory_order_release);
+
+		data.published.fetch_add(1, std::memory_order_release);
+		data.published.notify_one();
+	}
 }
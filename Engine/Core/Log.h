@@ -4,15 +4,128 @@
 #include "timer.h"
 #include "event.h"
 
+#include <atomic>
+
 namespace Iaonnis {
 
+	//Levels above this one are compiled out together with their arguments: 0 FATAL, 1 ERROR, 2 WARNING, 3 INFO, 4 DEBUG.
+	//Log::setLogLevel() filters further at runtime.
+#ifndef IAONNIS_LOG_COMPILE_LEVEL
+#ifdef _DEBUG
+#define IAONNIS_LOG_COMPILE_LEVEL 4
+#else
+#define IAONNIS_LOG_COMPILE_LEVEL 3
+#endif
+#endif
+
+	//Records waiting for the logging thread. When the ring is full FATAL and ERROR wait for room, other levels are dropped.
+	//Must be a power of two.
+#define IAONNIS_LOG_RING_CAPACITY 4096
+
+	//Serialized argument bytes per record, strings that do not fit are truncated.
+#define IAONNIS_LOG_ARGUMENT_BYTES 224
+
+#define IAONNIS_LOG_FATAL(fmt,...)  Log::fatal(__FILE__, __LINE__, fmt, ##__VA_ARGS__)
+
+#if IAONNIS_LOG_COMPILE_LEVEL >= 1
+#define IAONNIS_LOG_ERROR(fmt,...)  Log::error(__FILE__, __LINE__, fmt, ##__VA_ARGS__)
+#else
+#define IAONNIS_LOG_ERROR(fmt,...)  ((void)0)
+#endif
+
+#if IAONNIS_LOG_COMPILE_LEVEL >= 2
+#define IAONNIS_LOG_WARN(fmt, ...)  Log::warn(__FILE__,  __LINE__, fmt, ##__VA_ARGS__)
+#else
+#define IAONNIS_LOG_WARN(fmt, ...)  ((void)0)
+#endif
+
+#if IAONNIS_LOG_COMPILE_LEVEL >= 3
 #define IAONNIS_LOG_INFO(fmt, ...)  Log::info(__FILE__,  __LINE__, fmt, ##__VA_ARGS__)
+#else
+#define IAONNIS_LOG_INFO(fmt, ...)  ((void)0)
+#endif
+
+#if IAONNIS_LOG_COMPILE_LEVEL >= 4
 #define IAONNIS_LOG_DEBUG(fmt,...)  Log::debug(__FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define IAONNIS_LOG_WARN(fmt, ...)  Log::warn(__FILE__,  __LINE__, fmt, ##__VA_ARGS__)
-#define IAONNIS_LOG_ERROR(fmt,...)  Log::error(__FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define IAONNIS_LOG_FATAL(fmt,...)  Log::fatal(__FILE__, __LINE__, fmt, ##__VA_ARGS__)
+#else
+#define IAONNIS_LOG_DEBUG(fmt,...)  ((void)0)
+#endif
 
+	enum class LogArgumentType : uint8_t
+	{
+		Int,
+		UInt,
+		Double,
+		String,
+		Pointer,
+	};
+
+	/// @brief A log call as queued by the calling thread. format and file point to string literals,
+	/// the arguments are copied into arguments as (type, value) pairs and only formatted on the logging thread.
+	struct LogRecord
+	{
+		const char* format = nullptr;
+		const char* file = nullptr;
+		int line = 0;
+		uint8_t level = 0;
+		bool truncated = false;
+		uint16_t argumentBytes = 0;
+		int64_t time = 0;
+		uint8_t arguments[IAONNIS_LOG_ARGUMENT_BYTES];
+	};
+
+	namespace LogEncoding {
+
+		void WriteValue(LogRecord& record, LogArgumentType type, const void* value);
+		void WriteString(LogRecord& record, const char* text, size_t length);
+
+		template <typename T>
+		void Encode(LogRecord& record, const T& value)
+		{
+			using Type = std::decay_t<T>;
 
+			//Arrays, string literals included, can not be null.
+			if constexpr (std::is_array_v<T> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<T>>, char>)
+				WriteString(record, value, std::strlen(value));
+			else if constexpr (std::is_same_v<Type, char*> || std::is_same_v<Type, const char*>)
+			{
+				const char* text = value ? value : "(null)";
+				WriteString(record, text, std::strlen(text));
+			}
+			else if constexpr (std::is_same_v<Type, std::string> || std::is_same_v<Type, std::string_view>)
+				WriteString(record, value.data(), value.size());
+			else if constexpr (std::is_enum_v<Type> || std::is_same_v<Type, bool> || (std::is_integral_v<Type> && std::is_signed_v<Type>))
+			{
+				int64_t number = (int64_t)value;
+				WriteValue(record, LogArgumentType::Int, &number);
+			}
+			else if constexpr (std::is_integral_v<Type>)
+			{
+				uint64_t number = (uint64_t)value;
+				WriteValue(record, LogArgumentType::UInt, &number);
+			}
+			else if constexpr (std::is_floating_point_v<Type>)
+			{
+				double number = (double)value;
+				WriteValue(record, LogArgumentType::Double, &number);
+			}
+			else if constexpr (std::is_pointer_v<Type>)
+			{
+				uint64_t address = (uint64_t)(uintptr_t)value;
+				WriteValue(record, LogArgumentType::Pointer, &address);
+			}
+			else
+				static_assert(std::is_pointer_v<Type>, "Unsupported log argument type, pass strings as const char* or std::string.");
+		}
+	}
+
+	/// <summary>
+	/// Asynchronous printf-style logger. A log call only copies its arguments into a record of a lock-free ring;
+	/// the logging thread formats it, adds the timestamp, writes the console and file sinks and queues the line
+	/// for DispatchEvents(), which publishes it as a LogEvent on the main thread.
+	/// Before Initialize() and after Shutdown() records are written synchronously by the calling thread.
+	/// Any thread may log. FATAL records are flushed before the call returns.
+	/// </summary>
 	class Log
 	{
 	public:
@@ -30,83 +143,81 @@ namespace Iaonnis {
 		void setLogLevel(LogLevel level) { mLogLevel = level; }
 
 		static Log& logger();
+
+		/// @brief Starts the logging thread. An empty path disables the file sink.
+		static void Initialize(const std::string& logFile = "Iaonnis.log");
+
+		/// @brief Writes every queued record and stops the logging thread. Other threads must have stopped logging.
+		static void Shutdown();
+
+		/// @brief Blocks until every record queued before the call has been written.
+		static void Flush();
+
+		/// @brief Publishes the lines written since the last call as LogEvents. Main thread only.
+		static void DispatchEvents();
+
+		/// @brief Records dropped because the ring was full.
+		static uint64_t GetDroppedCount();
+
 		/// @brief base logging function
+		/// Serializes the arguments into a queued record, formatting happens on the logging thread.
 		template <typename... Args>
-		void log(LogLevel level, const std::string& file, int line, const std::string& fmt, Args&&... args)
+		void log(LogLevel level, const char* file, int line, const char* fmt, const Args&... args)
 		{
 			if (level > mLogLevel)
 				return;
 
-			// Get timestamp
-			std::string t;
-			IAONNIS_SYS_TIME(t);
-
-			std::string formattedMessage;
-
-#if __cplusplus >= 202002L
-			// ✅ C++20 and newer: use {} placeholders
-			if constexpr (sizeof...(args) > 0)
-			{
-				formattedMessage = std::vformat(fmt, std::make_format_args(std::forward<Args>(args)...));
-			}
-			else
-			{
-				formattedMessage = fmt;
-			}
-#else
-			// ✅ Pre-C++20: fallback to printf-style formatting (%s, %d, etc.)
-			if constexpr (sizeof...(args) > 0)
-			{
-				char buffer[4096];
-				std::snprintf(buffer, sizeof(buffer), fmt.c_str(), std::forward<Args>(args)...);
-				formattedMessage = buffer;
-			}
-			else
-			{
-				formattedMessage = fmt;
-			}
-#endif
+			LogRecord* record = BeginRecord(level);
+			if (!record)
+				return;
 
-			std::string logLevelString = kLogLevelStrings[(int)level].data();
-			std::string finalMessage = t + logLevelString + file + ":" + std::to_string(line) + " " + formattedMessage + "\n";
+			record->format = fmt;
+			record->file = file;
+			record->line = line;
+			(LogEncoding::Encode(*record, args), ...);
 
-			LogEvent logEvent(finalMessage.c_str());
-			EventBus::publish(logEvent);
+			CommitRecord(record);
 
-			std::cout << finalMessage.c_str() << std::endl;
+			if (level == LogLevel::FATAL)
+				Flush();
 		}
 
 
 		template <typename... Args>
-		static void fatal(const std::string& file, int line, const std::string& fmt, Args&&... args)
+		static void fatal(const char* file, int line, const char* fmt, const Args&... args)
 		{
-			logger().log(LogLevel::FATAL, file, line, fmt, std::forward<Args>(args)...);
+			logger().log(LogLevel::FATAL, file, line, fmt, args...);
 		}
 
 		template <typename... Args>
-		static void error(const std::string& file, int line, const std::string& fmt, Args&&... args)
+		static void error(const char* file, int line, const char* fmt, const Args&... args)
 		{
-			logger().log(LogLevel::ERROR, file, line, fmt, std::forward<Args>(args)...);
+			logger().log(LogLevel::ERROR, file, line, fmt, args...);
 		}
 
 		template <typename... Args>
-		static void warn(const std::string& file, int line, const std::string& fmt, Args&&... args)
+		static void warn(const char* file, int line, const char* fmt, const Args&... args)
 		{
-			logger().log(LogLevel::WARNING, file, line, fmt, std::forward<Args>(args)...);
+			logger().log(LogLevel::WARNING, file, line, fmt, args...);
 		}
 
 		template <typename... Args>
-		static void info(const std::string& file, int line, const std::string& fmt, Args&&... args)
+		static void info(const char* file, int line, const char* fmt, const Args&... args)
 		{
-			logger().log(LogLevel::INFO, file, line, fmt, std::forward<Args>(args)...);
+			logger().log(LogLevel::INFO, file, line, fmt, args...);
 		}
 
 		template <typename... Args>
-		static void debug(const std::string& file, int line, const std::string& fmt, Args&&... args)
+		static void debug(const char* file, int line, const char* fmt, const Args&... args)
 		{
-			logger().log(LogLevel::DEBUG, file, line, fmt, std::forward<Args>(args)...);
+			logger().log(LogLevel::DEBUG, file, line, fmt, args...);
 		}
 
 		LogLevel mLogLevel = LogLevel::DEBUG;
+
+	private:
+		/// @brief Claims a record, or returns nullptr if it had to be dropped. Must be followed by CommitRecord().
+		static LogRecord* BeginRecord(LogLevel level);
+		static void CommitRecord(LogRecord* record);
 	};
 }
\ No newline at end of file
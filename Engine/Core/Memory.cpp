@@ -0,0 +1,242 @@
+#include "Memory.h"
+
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+namespace Iaonnis {
+
+	namespace {
+
+		struct TagCounters
+		{
+			std::atomic<int64_t> liveBytes{ 0 };
+			std::atomic<int64_t> liveAllocations{ 0 };
+			std::atomic<int64_t> peakBytes{ 0 };
+
+			std::atomic<int64_t> totalBytes{ 0 };
+			std::atomic<int64_t> totalAllocations{ 0 };
+
+			std::atomic<int64_t> gpuBytes{ 0 };
+
+			//Written by NewFrame() only.
+			int64_t frameStartBytes = 0;
+			int64_t frameStartAllocations = 0;
+			std::atomic<int64_t> frameBytes{ 0 };
+			std::atomic<int64_t> frameAllocations{ 0 };
+		};
+
+		//Plain atomics are constant initialized, so allocations made before main() are counted as well.
+		TagCounters counters[(int)MemoryTag::Count];
+
+		thread_local MemoryTag currentTag = MemoryTag::General;
+		thread_local AllocationCounter threadAllocations;
+
+		std::atomic<bool> zeroAllocationArmed{ false };
+		std::atomic<uint64_t> violationCount{ 0 };
+
+		//Fixed storage, reporting a violation must not allocate itself.
+		std::mutex violationMutex;
+		AllocationViolation violations[IAONNIS_MAX_ALLOCATION_VIOLATIONS];
+		uint32_t pendingViolations = 0;
+
+#if IAONNIS_MEMORY_TRACKING
+		/// Sits in front of every block. 32 bytes keeps the returned pointer at the default new alignment.
+		struct alignas(16) AllocationHeader
+		{
+			void* base;
+			size_t size;
+			MemoryTag tag;
+		};
+		static_assert(sizeof(AllocationHeader) <= 32, "AllocationHeader must fit in 32 bytes.");
+
+		constexpr size_t HEADER_SIZE = 32;
+
+		void* TrackedAllocate(size_t size, size_t alignment)
+		{
+			if (alignment < HEADER_SIZE)
+				alignment = HEADER_SIZE;
+
+			void* base = std::malloc(size + alignment + HEADER_SIZE);
+			if (!base)
+				return nullptr;
+
+			uintptr_t user = ((uintptr_t)base + HEADER_SIZE + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+			AllocationHeader* header = reinterpret_cast<AllocationHeader*>(user - HEADER_SIZE);
+			header->base = base;
+			header->size = size;
+			header->tag = currentTag;
+
+			threadAllocations.allocations++;
+			threadAllocations.bytes += (int64_t)size;
+
+			MemoryTracker::OnAllocate(header->tag, size);
+			return reinterpret_cast<void*>(user);
+		}
+
+		void TrackedFree(void* memory)
+		{
+			if (!memory)
+				return;
+
+			AllocationHeader* header = reinterpret_cast<AllocationHeader*>((uintptr_t)memory - HEADER_SIZE);
+			MemoryTracker::OnFree(header->tag, header->size);
+			std::free(header->base);
+		}
+
+		void* AllocateOrThrow(size_t size, size_t alignment)
+		{
+			void* memory = TrackedAllocate(size ? size : 1, alignment);
+			if (!memory)
+				throw std::bad_alloc();
+			return memory;
+		}
+#endif
+	}
+
+	MemoryTag MemoryTracker::GetCurrentTag()
+	{
+		return currentTag;
+	}
+
+	void MemoryTracker::SetCurrentTag(MemoryTag tag)
+	{
+		currentTag = tag;
+	}
+
+	void MemoryTracker::OnAllocate(MemoryTag tag, size_t bytes)
+	{
+		TagCounters& counter = counters[(int)tag];
+		int64_t live = counter.liveBytes.fetch_add((int64_t)bytes, std::memory_order_relaxed) + (int64_t)bytes;
+		counter.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+		counter.totalBytes.fetch_add((int64_t)bytes, std::memory_order_relaxed);
+		counter.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+
+		int64_t peak = counter.peakBytes.load(std::memory_order_relaxed);
+		while (live > peak && !counter.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+	}
+
+	void MemoryTracker::OnFree(MemoryTag tag, size_t bytes)
+	{
+		TagCounters& counter = counters[(int)tag];
+		counter.liveBytes.fetch_sub((int64_t)bytes, std::memory_order_relaxed);
+		counter.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::TrackGPU(MemoryTag tag, int64_t bytes)
+	{
+		counters[(int)tag].gpuBytes.fetch_add(bytes, std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::NewFrame()
+	{
+		for (auto& counter : counters)
+		{
+			int64_t totalBytes = counter.totalBytes.load(std::memory_order_relaxed);
+			int64_t totalAllocations = counter.totalAllocations.load(std::memory_order_relaxed);
+
+			counter.frameBytes.store(totalBytes - counter.frameStartBytes, std::memory_order_relaxed);
+			counter.frameAllocations.store(totalAllocations - counter.frameStartAllocations, std::memory_order_relaxed);
+
+			counter.frameStartBytes = totalBytes;
+			counter.frameStartAllocations = totalAllocations;
+		}
+	}
+
+	MemoryTagStats MemoryTracker::GetStats(MemoryTag tag)
+	{
+		TagCounters& counter = counters[(int)tag];
+
+		MemoryTagStats stats;
+		stats.liveBytes = counter.liveBytes.load(std::memory_order_relaxed);
+		stats.liveAllocations = counter.liveAllocations.load(std::memory_order_relaxed);
+		stats.peakBytes = counter.peakBytes.load(std::memory_order_relaxed);
+		stats.frameBytes = counter.frameBytes.load(std::memory_order_relaxed);
+		stats.frameAllocations = counter.frameAllocations.load(std::memory_order_relaxed);
+		stats.gpuBytes = counter.gpuBytes.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	const char* MemoryTracker::GetTagName(MemoryTag tag)
+	{
+		switch (tag)
+		{
+			case MemoryTag::General: return "General";
+			case MemoryTag::Mesh: return "Mesh";
+			case MemoryTag::Texture: return "Texture";
+			case MemoryTag::Scene: return "Scene";
+			case MemoryTag::Renderer: return "Renderer";
+			case MemoryTag::Editor: return "Editor";
+			case MemoryTag::Log: return "Log";
+			case MemoryTag::Count: break;
+		}
+
+		return "Unknown";
+	}
+
+	AllocationCounter MemoryTracker::GetThreadAllocations()
+	{
+		return threadAllocations;
+	}
+
+	void MemoryTracker::ArmZeroAllocationCheck(bool armed)
+	{
+		zeroAllocationArmed.store(armed, std::memory_order_relaxed);
+	}
+
+	bool MemoryTracker::IsZeroAllocationCheckArmed()
+	{
+		return zeroAllocationArmed.load(std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::ReportAllocationViolation(const char* scope, const AllocationCounter& allocated)
+	{
+		violationCount.fetch_add(1, std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> lock(violationMutex);
+		if (pendingViolations < IAONNIS_MAX_ALLOCATION_VIOLATIONS)
+			violations[pendingViolations++] = { scope, allocated.allocations, allocated.bytes };
+	}
+
+	bool MemoryTracker::PopAllocationViolation(AllocationViolation& violation)
+	{
+		std::lock_guard<std::mutex> lock(violationMutex);
+		if (pendingViolations == 0)
+			return false;
+
+		violation = violations[--pendingViolations];
+		return true;
+	}
+
+	uint64_t MemoryTracker::GetAllocationViolationCount()
+	{
+		return violationCount.load(std::memory_order_relaxed);
+	}
+}
+
+#if IAONNIS_MEMORY_TRACKING
+
+//Global replacements, every new/delete in the engine and its statically linked libraries ends up here.
+void* operator new(size_t size) { return Iaonnis::AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](size_t size) { return Iaonnis::AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(size_t size, const std::nothrow_t&)noexcept { return Iaonnis::TrackedAllocate(size ? size : 1, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](size_t size, const std::nothrow_t&)noexcept { return Iaonnis::TrackedAllocate(size ? size : 1, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(size_t size, std::align_val_t alignment) { return Iaonnis::AllocateOrThrow(size, (size_t)alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return Iaonnis::AllocateOrThrow(size, (size_t)alignment); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&)noexcept { return Iaonnis::TrackedAllocate(size ? size : 1, (size_t)alignment); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&)noexcept { return Iaonnis::TrackedAllocate(size ? size : 1, (size_t)alignment); }
+
+void operator delete(void* memory)noexcept { Iaonnis::TrackedFree(memory); }
+void operator delete[](void* memory)noexcept { Iaonnis::TrackedFree(memory); }
+void operator delete(void* memory, size_t)noexcept { Iaonnis::TrackedFree(memory); }
+void operator delete[](void* memory, size_t)noexcept { Iaonnis::TrackedFree(memory); }
+void operator delete(void* memory, const std::nothrow_t&)noexcept { Iaonnis::TrackedFree(memory); }
+void operator delete[](void* memory, const std::nothrow_t&)noexcept { Iaonnis::TrackedFree(memory); }
+void operator delete(void* memory, std::align_val_t)noexcept { Iaonnis::TrackedFree(memory); }
+void operator delete[](void* memory, std::align_val_t)noexcept { Iaonnis::TrackedFree(memory); }
+void operator delete(void* memory, size_t, std::align_val_t)noexcept { Iaonnis::TrackedFree(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t)noexcept { Iaonnis::TrackedFree(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&)noexcept { Iaonnis::TrackedFree(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&)noexcept { Iaonnis::TrackedFree(memory); }
+#endif
@@ -0,0 +1,149 @@
+#pragma once
+#include "pch.h"
+
+#include <atomic>
+
+namespace Iaonnis {
+
+	//Replaces the global operator new/delete to count heap allocations. Defaults to debug builds only,
+	//without it tags and GPU estimates still work but every heap counter stays at 0.
+#ifndef IAONNIS_MEMORY_TRACKING
+#ifdef _DEBUG
+#define IAONNIS_MEMORY_TRACKING 1
+#else
+#define IAONNIS_MEMORY_TRACKING 0
+#endif
+#endif
+
+	//Violations kept between two calls to MemoryTracker::PopAllocationViolation(). Extra ones are only counted.
+#define IAONNIS_MAX_ALLOCATION_VIOLATIONS 32
+
+	enum class MemoryTag : uint8_t
+	{
+		General,
+		Mesh,
+		Texture,
+		Scene,
+		Renderer,
+		Editor,
+		Log,
+
+		Count
+	};
+
+	struct MemoryTagStats
+	{
+		int64_t liveBytes = 0;
+		int64_t liveAllocations = 0;
+		int64_t peakBytes = 0;
+
+		/// @brief Bytes and allocations made during the last completed frame.
+		int64_t frameBytes = 0;
+		int64_t frameAllocations = 0;
+
+		/// @brief Estimated GPU memory owned by the tag. Reported by the code that creates the GPU objects.
+		int64_t gpuBytes = 0;
+	};
+
+	/// @brief Heap allocations made by one thread since it started. Differences of two reads give the allocations of a scope.
+	struct AllocationCounter
+	{
+		int64_t allocations = 0;
+		int64_t bytes = 0;
+	};
+
+	/// @brief Heap allocations that happened inside a scope marked IAONNIS_ASSERT_NO_ALLOCATIONS while the check was armed.
+	struct AllocationViolation
+	{
+		const char* scope = nullptr;
+		int64_t allocations = 0;
+		int64_t bytes = 0;
+	};
+
+	/// <summary>
+	/// Attributes every heap allocation to the MemoryTag active on the allocating thread.
+	/// With IAONNIS_MEMORY_TRACKING the global operator new/delete are replaced in Memory.cpp, each block carries a small header with its size and tag
+	/// so the free is charged to the tag that allocated it, whichever thread or scope releases it.
+	/// Memory that does not go through operator new (malloc in vendor code, GL driver memory) is not seen.
+	/// </summary>
+	class MemoryTracker
+	{
+	public:
+		static MemoryTag GetCurrentTag();
+		static void SetCurrentTag(MemoryTag tag);
+
+		static void OnAllocate(MemoryTag tag, size_t bytes);
+		static void OnFree(MemoryTag tag, size_t bytes);
+
+		/// @brief Adds (or with a negative value removes) an estimate of GPU memory.
+		static void TrackGPU(MemoryTag tag, int64_t bytes);
+
+		/// @brief Closes the per-frame counters. Call once per frame.
+		static void NewFrame();
+
+		static MemoryTagStats GetStats(MemoryTag tag);
+		static const char* GetTagName(MemoryTag tag);
+
+		/// @brief Running totals of the calling thread.
+		static AllocationCounter GetThreadAllocations();
+
+		/// @brief While armed, every IAONNIS_ASSERT_NO_ALLOCATIONS scope that allocates records a violation.
+		/// Meant to be armed for steady-state frames only, loading or editing the scene allocates by design.
+		static void ArmZeroAllocationCheck(bool armed);
+		static bool IsZeroAllocationCheckArmed();
+
+		/// @brief Any thread. Does not allocate and does not log, the main thread reports through PopAllocationViolation().
+		static void ReportAllocationViolation(const char* scope, const AllocationCounter& allocated);
+		static bool PopAllocationViolation(AllocationViolation& violation);
+		static uint64_t GetAllocationViolationCount();
+	};
+
+	/// @brief Charges every allocation made on this thread to tag until the scope ends.
+	class MemoryTagScope
+	{
+	public:
+		explicit MemoryTagScope(MemoryTag tag) :previous(MemoryTracker::GetCurrentTag()) { MemoryTracker::SetCurrentTag(tag); }
+		~MemoryTagScope() { MemoryTracker::SetCurrentTag(previous); }
+
+		MemoryTagScope(const MemoryTagScope&) = delete;
+		MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+	private:
+		MemoryTag previous;
+	};
+
+	/// @brief Records a violation if the enclosing scope allocates on the heap while the zero-allocation check is armed.
+	/// Only allocations of the calling thread are seen: jobs it waits on are missed when they run on a worker,
+	/// while any job it picks up itself during JobSystem::Wait() is charged to the scope.
+	class NoAllocationScope
+	{
+	public:
+		explicit NoAllocationScope(const char* scope) :scope(scope), start(MemoryTracker::GetThreadAllocations()) {}
+		~NoAllocationScope()
+		{
+			if (!MemoryTracker::IsZeroAllocationCheckArmed())
+				return;
+
+			AllocationCounter end = MemoryTracker::GetThreadAllocations();
+			if (end.allocations != start.allocations)
+				MemoryTracker::ReportAllocationViolation(scope, { end.allocations - start.allocations, end.bytes - start.bytes });
+		}
+
+		NoAllocationScope(const NoAllocationScope&) = delete;
+		NoAllocationScope& operator=(const NoAllocationScope&) = delete;
+
+	private:
+		const char* scope;
+		AllocationCounter start;
+	};
+
+#define IAONNIS_MEMORY_CONCAT_IMPL(a, b) a##b
+#define IAONNIS_MEMORY_CONCAT(a, b) IAONNIS_MEMORY_CONCAT_IMPL(a, b)
+#define IAONNIS_MEMORY_TAG(tag) ::Iaonnis::MemoryTagScope IAONNIS_MEMORY_CONCAT(memoryTagScope_, __LINE__)(tag)
+
+#if IAONNIS_MEMORY_TRACKING
+#define IAONNIS_ASSERT_NO_ALLOCATIONS(scope) ::Iaonnis::NoAllocationScope IAONNIS_MEMORY_CONCAT(noAllocationScope_, __LINE__)(scope)
+#else
+#define IAONNIS_ASSERT_NO_ALLOCATIONS(scope) ((void)0)
+#endif
+}
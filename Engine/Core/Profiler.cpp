@@ -0,0 +1,539 @@
+#include "Profiler.h"
+
+#include "Log.h"
+
+#include <mutex>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+namespace Iaonnis {
+
+	static_assert((IAONNIS_PROFILER_RING_CAPACITY & (IAONNIS_PROFILER_RING_CAPACITY - 1)) == 0, "Profiler ring capacity must be a power of two.");
+
+	namespace {
+
+		/// Single producer (the owning thread), single consumer (EndFrame on the main thread).
+		struct ThreadBuffer
+		{
+			ProfileEvent events[IAONNIS_PROFILER_RING_CAPACITY];
+			std::atomic<uint64_t> writeIndex{ 0 };
+			std::atomic<uint64_t> readIndex{ 0 };
+			std::atomic<uint64_t> dropped{ 0 };
+
+			//Only touched by the owning thread.
+			uint32_t depth = 0;
+
+			//Guarded by the registry mutex.
+			std::string name;
+		};
+
+		struct CaptureThread
+		{
+			std::string name;
+			std::vector<ProfileEvent> events;
+		};
+
+		struct Capture
+		{
+			bool active = false;
+			uint32_t framesLeft = 0;
+			filespace::filepath path;
+
+			std::vector<std::pair<int64_t, int64_t>> frames;
+			std::vector<CaptureThread> threads;
+			std::vector<std::pair<std::string, std::string>> metadata;
+		};
+
+		struct HistoryFrame
+		{
+			int64_t startNs = 0;
+			int64_t endNs = 0;
+			std::vector<std::vector<ProfileEvent>> threads;
+		};
+
+		/// Ring of the last historyFrames frames. The vectors are reused so steady state does not allocate.
+		struct HitchDetector
+		{
+			double thresholdMs = 0.0;
+			uint32_t historyFrames = 120;
+
+			std::vector<HistoryFrame> history;
+			uint32_t next = 0;
+			uint32_t count = 0;
+
+			uint32_t cooldown = 0;
+			uint32_t hitches = 0;
+		};
+
+		struct Registry
+		{
+			std::mutex mutex;
+			std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+			ProfileFrame lastFrame;
+			uint64_t frameIndex = 0;
+			int64_t frameStartNs = 0;
+
+			Capture capture;
+			uint32_t captureFrameCount = 120;
+
+			HitchDetector hitchDetector;
+			ProfileMetadataProvider metadataProvider;
+		};
+
+		Registry& GetRegistry()
+		{
+			static Registry registry;
+			return registry;
+		}
+
+		thread_local ThreadBuffer* threadBuffer = nullptr;
+
+		ThreadBuffer& GetThreadBuffer()
+		{
+			if (threadBuffer)
+				return *threadBuffer;
+
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+
+			registry.buffers.push_back(std::make_unique<ThreadBuffer>());
+			threadBuffer = registry.buffers.back().get();
+			threadBuffer->name = "Thread " + std::to_string(registry.buffers.size() - 1);
+			return *threadBuffer;
+		}
+
+		bool SameName(const char* a, const char* b)
+		{
+			return a == b || std::strcmp(a, b) == 0;
+		}
+
+		void WriteJsonString(std::ostream& out, const char* string)
+		{
+			out << '"';
+			for (const char* c = string; *c; c++)
+			{
+				if (*c == '"' || *c == '\\')
+					out << '\\' << *c;
+				else if ((unsigned char)*c < 0x20)
+					out << ' ';
+				else
+					out << *c;
+			}
+			out << '"';
+		}
+
+		/// Complete ("X") events per thread plus one track for the frame boundaries. Timestamps are microseconds from the capture start.
+		bool WriteChromeTrace(const Capture& capture)
+		{
+			std::ofstream file(capture.path, std::ios::binary);
+			if (!file)
+				return false;
+
+			int64_t origin = capture.frames.empty() ? 0 : capture.frames.front().first;
+			auto micro = [origin](int64_t ns) { return (ns - origin) / 1000.0; };
+
+			file << std::fixed << std::setprecision(3);
+			file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+			file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Iaonnis\"}}";
+
+			const uint32_t frameTrack = (uint32_t)capture.threads.size();
+			file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << frameTrack << ",\"args\":{\"name\":\"Frames\"}}";
+			for (size_t i = 0; i < capture.frames.size(); i++)
+			{
+				auto& [start, end] = capture.frames[i];
+				file << ",\n{\"name\":\"Frame " << i << "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":" << frameTrack
+					<< ",\"ts\":" << micro(start) << ",\"dur\":" << (end - start) / 1000.0 << "}";
+			}
+
+			for (uint32_t tid = 0; tid < capture.threads.size(); tid++)
+			{
+				const CaptureThread& thread = capture.threads[tid];
+				if (thread.events.empty())
+					continue;
+
+				file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"name\":";
+				WriteJsonString(file, thread.name.c_str());
+				file << "}}";
+				file << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"sort_index\":" << tid << "}}";
+
+				for (const ProfileEvent& event : thread.events)
+				{
+					file << ",\n{\"name\":";
+					WriteJsonString(file, event.name);
+					file << ",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+						<< ",\"ts\":" << micro(event.startNs) << ",\"dur\":" << (event.endNs - event.startNs) / 1000.0;
+					if (event.allocations)
+						file << ",\"args\":{\"allocations\":" << event.allocations << ",\"bytes\":" << event.allocatedBytes << "}";
+					file << "}";
+				}
+			}
+
+			file << "\n]";
+			if (!capture.metadata.empty())
+			{
+				file << ",\"otherData\":{";
+				for (size_t i = 0; i < capture.metadata.size(); i++)
+				{
+					file << (i ? ",\n" : "\n");
+					WriteJsonString(file, capture.metadata[i].first.c_str());
+					file << ':';
+					WriteJsonString(file, capture.metadata[i].second.c_str());
+				}
+				file << "\n}";
+			}
+			file << "}\n";
+			return (bool)file;
+		}
+
+		void AppendEvents(Capture& capture, size_t thread, const std::string& name, const std::vector<ProfileEvent>& events)
+		{
+			if (capture.threads.size() <= thread)
+				capture.threads.resize(thread + 1);
+
+			capture.threads[thread].name = name;
+			capture.threads[thread].events.insert(capture.threads[thread].events.end(), events.begin(), events.end());
+		}
+
+		void AddMetadata(Registry& registry, Capture& capture)
+		{
+			if (registry.metadataProvider)
+				registry.metadataProvider(capture.metadata);
+		}
+
+		void RecordHistory(HitchDetector& detector, const ProfileFrame& frame)
+		{
+			if (detector.history.size() != detector.historyFrames)
+			{
+				detector.history.assign(detector.historyFrames, HistoryFrame());
+				detector.next = 0;
+				detector.count = 0;
+			}
+
+			HistoryFrame& slot = detector.history[detector.next];
+			slot.startNs = frame.startNs;
+			slot.endNs = frame.endNs;
+			slot.threads.resize(frame.threads.size());
+			for (size_t i = 0; i < frame.threads.size(); i++)
+				slot.threads[i].assign(frame.threads[i].events.begin(), frame.threads[i].events.end());
+
+			detector.next = (detector.next + 1) % detector.historyFrames;
+			detector.count = std::min(detector.count + 1, detector.historyFrames);
+		}
+
+		void DumpHitch(Registry& registry, const ProfileFrame& frame)
+		{
+			HitchDetector& detector = registry.hitchDetector;
+			double frameMs = (frame.endNs - frame.startNs) / 1e6;
+
+			Capture capture;
+			filespace::filepath directory = IAONNIS_PROFILER_HITCH_DIRECTORY;
+			std::error_code error;
+			std::filesystem::create_directories(directory, error);
+			capture.path = directory / ("Hitch_" + std::to_string(frame.index) + ".json");
+
+			uint32_t oldest = (detector.next + detector.historyFrames - detector.count) % detector.historyFrames;
+			for (uint32_t i = 0; i < detector.count; i++)
+			{
+				const HistoryFrame& history = detector.history[(oldest + i) % detector.historyFrames];
+				capture.frames.push_back({ history.startNs, history.endNs });
+				for (size_t t = 0; t < history.threads.size(); t++)
+					AppendEvents(capture, t, frame.threads[t].name, history.threads[t]);
+			}
+
+			capture.metadata.push_back({ "Hitch Frame", std::to_string(frame.index) });
+			capture.metadata.push_back({ "Hitch Duration (ms)", std::to_string(frameMs) });
+			capture.metadata.push_back({ "Hitch Threshold (ms)", std::to_string(detector.thresholdMs) });
+			AddMetadata(registry, capture);
+
+			detector.hitches++;
+			detector.cooldown = detector.historyFrames;
+
+			if (WriteChromeTrace(capture))
+				IAONNIS_LOG_WARN("Frame hitch of %.3f ms, the last %u frames were written. (Path = %s)", frameMs, detector.count, capture.path.string().c_str());
+			else
+				IAONNIS_LOG_ERROR("Failed to write hitch capture. (Path = %s)", capture.path.string().c_str());
+
+			if (detector.hitches >= IAONNIS_PROFILER_MAX_HITCH_CAPTURES)
+			{
+				IAONNIS_LOG_WARN("Hitch detection disabled after %u captures.", detector.hitches);
+				Profiler::SetHitchDetection(0.0, detector.historyFrames);
+			}
+		}
+
+		void AppendPreOrder(const std::vector<ProfileNode>& nodes, int32_t index, std::vector<ProfileNode>& out)
+		{
+			for (; index != -1; index = nodes[index].nextSibling)
+			{
+				int32_t outIndex = (int32_t)out.size();
+				out.push_back(nodes[index]);
+				out[outIndex].firstChild = -1;
+				out[outIndex].nextSibling = -1;
+
+				if (nodes[index].firstChild != -1)
+				{
+					out[outIndex].firstChild = (int32_t)out.size();
+					AppendPreOrder(nodes, nodes[index].firstChild, out);
+				}
+
+				if (nodes[index].nextSibling != -1)
+					out[outIndex].nextSibling = (int32_t)out.size();
+			}
+		}
+
+		/// Zones carry their depth, so the parent of a zone is whatever is open one level up when it starts.
+		/// A zone whose parent started in an earlier frame is attached to the deepest zone still open.
+		void BuildTree(ProfileThreadFrame& thread)
+		{
+			std::vector<ProfileNode> nodes;
+			std::vector<int32_t> lastChild;
+			std::vector<std::pair<int32_t, uint32_t>> stack;
+			int32_t lastRoot = -1;
+
+			for (const ProfileEvent& event : thread.events)
+			{
+				while (!stack.empty() && stack.back().second >= event.depth)
+					stack.pop_back();
+
+				int32_t parent = stack.empty() ? -1 : stack.back().first;
+				int32_t first = parent == -1 ? (nodes.empty() ? -1 : 0) : nodes[parent].firstChild;
+
+				int32_t match = -1;
+				for (int32_t sibling = first; sibling != -1; sibling = nodes[sibling].nextSibling)
+				{
+					if (SameName(nodes[sibling].name, event.name))
+					{
+						match = sibling;
+						break;
+					}
+				}
+
+				if (match == -1)
+				{
+					match = (int32_t)nodes.size();
+					ProfileNode node;
+					node.name = event.name;
+					node.depth = (uint32_t)stack.size();
+					nodes.push_back(node);
+					lastChild.push_back(-1);
+
+					int32_t& previous = parent == -1 ? lastRoot : lastChild[parent];
+					if (previous != -1)
+						nodes[previous].nextSibling = match;
+					else if (parent != -1)
+						nodes[parent].firstChild = match;
+					previous = match;
+				}
+
+				double durationMs = (event.endNs - event.startNs) / 1e6;
+				nodes[match].calls++;
+				nodes[match].totalMs += durationMs;
+				nodes[match].allocations += event.allocations;
+				nodes[match].allocatedBytes += event.allocatedBytes;
+				nodes[match].selfMs += durationMs;
+				if (parent != -1)
+					nodes[parent].selfMs -= durationMs;
+
+				stack.push_back({ match, event.depth });
+			}
+
+			thread.tree.clear();
+			thread.tree.reserve(nodes.size());
+			if (!nodes.empty())
+				AppendPreOrder(nodes, 0, thread.tree);
+		}
+	}
+
+	int64_t Profiler::Now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	void Profiler::SetThreadName(const std::string& name)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+
+		std::lock_guard<std::mutex> lock(GetRegistry().mutex);
+		buffer.name = name;
+	}
+
+	uint32_t Profiler::PushZone()
+	{
+		return GetThreadBuffer().depth++;
+	}
+
+	void Profiler::PopZone(const char* name, int64_t startNs, uint32_t depth, const AllocationCounter& startAllocations)
+	{
+		int64_t endNs = Now();
+		AllocationCounter endAllocations = MemoryTracker::GetThreadAllocations();
+
+		ThreadBuffer& buffer = *threadBuffer;
+		buffer.depth = depth;
+
+		uint64_t write = buffer.writeIndex.load(std::memory_order_relaxed);
+		if (write - buffer.readIndex.load(std::memory_order_acquire) >= IAONNIS_PROFILER_RING_CAPACITY)
+		{
+			buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		ProfileEvent& event = buffer.events[write & (IAONNIS_PROFILER_RING_CAPACITY - 1)];
+		event.name = name;
+		event.startNs = startNs;
+		event.endNs = endNs;
+		event.depth = depth;
+		event.allocations = endAllocations.allocations - startAllocations.allocations;
+		event.allocatedBytes = endAllocations.bytes - startAllocations.bytes;
+
+		buffer.writeIndex.store(write + 1, std::memory_order_release);
+	}
+
+	void Profiler::EndFrame()
+	{
+		Registry& registry = GetRegistry();
+		int64_t now = Now();
+
+		ProfileFrame& frame = registry.lastFrame;
+		frame.index = registry.frameIndex++;
+		frame.startNs = registry.frameStartNs ? registry.frameStartNs : now;
+		frame.endNs = now;
+		frame.droppedEvents = 0;
+		registry.frameStartNs = now;
+
+		//Buffers are never freed, only the list itself needs the lock. Threads registering meanwhile show up next frame.
+		std::vector<ThreadBuffer*> buffers;
+		{
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			frame.threads.resize(registry.buffers.size());
+			for (size_t i = 0; i < registry.buffers.size(); i++)
+			{
+				buffers.push_back(registry.buffers[i].get());
+				frame.threads[i].name = registry.buffers[i]->name;
+			}
+		}
+
+		for (size_t i = 0; i < buffers.size(); i++)
+		{
+			ThreadBuffer& buffer = *buffers[i];
+			ProfileThreadFrame& thread = frame.threads[i];
+			thread.events.clear();
+
+			uint64_t read = buffer.readIndex.load(std::memory_order_relaxed);
+			uint64_t write = buffer.writeIndex.load(std::memory_order_acquire);
+			for (; read != write; read++)
+				thread.events.push_back(buffer.events[read & (IAONNIS_PROFILER_RING_CAPACITY - 1)]);
+			buffer.readIndex.store(write, std::memory_order_release);
+
+			frame.droppedEvents += buffer.dropped.exchange(0, std::memory_order_relaxed);
+
+			//Zones are written when they close, children before their parent. The tree wants them in the order they opened.
+			std::sort(thread.events.begin(), thread.events.end(), [](const ProfileEvent& a, const ProfileEvent& b)
+				{
+					return a.startNs != b.startNs ? a.startNs < b.startNs : a.depth < b.depth;
+				});
+
+			BuildTree(thread);
+		}
+
+		HitchDetector& detector = registry.hitchDetector;
+		if (detector.thresholdMs > 0.0)
+		{
+			RecordHistory(detector, frame);
+
+			//Nothing is reported until the window is full, the first frames are always slow.
+			bool hitch = (frame.endNs - frame.startNs) / 1e6 > detector.thresholdMs;
+			if (detector.cooldown > 0)
+				detector.cooldown--;
+			else if (hitch && detector.count == detector.historyFrames)
+				DumpHitch(registry, frame);
+		}
+
+		Capture& capture = registry.capture;
+		if (!capture.active)
+			return;
+
+		capture.frames.push_back({ frame.startNs, frame.endNs });
+		for (size_t i = 0; i < frame.threads.size(); i++)
+			AppendEvents(capture, i, frame.threads[i].name, frame.threads[i].events);
+
+		if (--capture.framesLeft > 0)
+			return;
+
+		AddMetadata(registry, capture);
+
+		//Written here on the main thread: the hitch lands after the captured frames and the log stays single threaded.
+		if (WriteChromeTrace(capture))
+			IAONNIS_LOG_INFO("Profiler capture written. (Frames = %zu, Path = %s)", capture.frames.size(), capture.path.string().c_str());
+		else
+			IAONNIS_LOG_ERROR("Failed to write profiler capture. (Path = %s)", capture.path.string().c_str());
+
+		capture = Capture();
+
+		//Writing the file stretches the next frame, do not report it as a hitch.
+		detector.cooldown = std::max(detector.cooldown, detector.historyFrames);
+	}
+
+	const ProfileFrame& Profiler::GetLastFrame()
+	{
+		return GetRegistry().lastFrame;
+	}
+
+	void Profiler::BeginCapture(uint32_t frameCount, const filespace::filepath& path)
+	{
+		Capture& capture = GetRegistry().capture;
+		if (capture.active)
+		{
+			IAONNIS_LOG_WARN("A profiler capture is already running. (Path = %s)", capture.path.string().c_str());
+			return;
+		}
+
+		capture.active = true;
+		capture.framesLeft = frameCount ? frameCount : 1;
+		capture.path = path.empty() ? filespace::filepath("ProfilerCapture_" + std::to_string(GetRegistry().frameIndex) + ".json") : path;
+		IAONNIS_LOG_INFO("Profiler capture started. (Frames = %u)", capture.framesLeft);
+	}
+
+	bool Profiler::IsCapturing()
+	{
+		return GetRegistry().capture.active;
+	}
+
+	void Profiler::SetCaptureFrameCount(uint32_t frameCount)
+	{
+		GetRegistry().captureFrameCount = frameCount ? frameCount : 1;
+	}
+
+	uint32_t Profiler::GetCaptureFrameCount()
+	{
+		return GetRegistry().captureFrameCount;
+	}
+
+	void Profiler::SetHitchDetection(double thresholdMs, uint32_t historyFrames)
+	{
+		HitchDetector& detector = GetRegistry().hitchDetector;
+		detector.thresholdMs = thresholdMs;
+		detector.historyFrames = historyFrames ? historyFrames : 1;
+
+		if (thresholdMs <= 0.0)
+		{
+			detector.history.clear();
+			detector.count = 0;
+		}
+	}
+
+	double Profiler::GetHitchThreshold()
+	{
+		return GetRegistry().hitchDetector.thresholdMs;
+	}
+
+	uint32_t Profiler::GetHitchCount()
+	{
+		return GetRegistry().hitchDetector.hitches;
+	}
+
+	void Profiler::SetMetadataProvider(ProfileMetadataProvider provider)
+	{
+		GetRegistry().metadataProvider = std::move(provider);
+	}
+}
@@ -0,0 +1,154 @@
+#pragma once
+#include "pch.h"
+#include "Utils.h"
+#include "Memory.h"
+
+#include <atomic>
+
+namespace Iaonnis {
+
+	//Set to 0 to compile every zone macro out.
+#ifndef IAONNIS_PROFILER_ENABLED
+#define IAONNIS_PROFILER_ENABLED 1
+#endif
+
+	//Zones each thread can record between two Profiler::EndFrame() calls. Must be a power of two.
+#define IAONNIS_PROFILER_RING_CAPACITY 8192
+
+	//Hitch captures are written to this directory, relative to the working directory. The detector turns itself off
+	//after IAONNIS_PROFILER_MAX_HITCH_CAPTURES dumps so a slow machine does not fill the disk.
+#define IAONNIS_PROFILER_HITCH_DIRECTORY "Captures/Hitches"
+#define IAONNIS_PROFILER_MAX_HITCH_CAPTURES 16
+
+	/// @brief One closed zone as recorded by the thread that ran it. Times are steady clock nanoseconds.
+	struct ProfileEvent
+	{
+		const char* name = nullptr;
+		int64_t startNs = 0;
+		int64_t endNs = 0;
+		uint32_t depth = 0;
+
+		/// @brief Heap allocations made by the zone and its children. 0 without IAONNIS_MEMORY_TRACKING.
+		int64_t allocations = 0;
+		int64_t allocatedBytes = 0;
+	};
+
+	/// @brief Node of the per-frame call tree. Calls of the same zone under the same parent are merged.
+	struct ProfileNode
+	{
+		const char* name = nullptr;
+		uint32_t depth = 0;
+		uint32_t calls = 0;
+		double totalMs = 0.0;
+		double selfMs = 0.0;
+
+		/// @brief Summed over every call, children included.
+		int64_t allocations = 0;
+		int64_t allocatedBytes = 0;
+
+		int32_t firstChild = -1;
+		int32_t nextSibling = -1;
+	};
+
+	struct ProfileThreadFrame
+	{
+		std::string name;
+
+		/// @brief Raw zones ordered by start time.
+		std::vector<ProfileEvent> events;
+
+		/// @brief Call tree in pre-order, the roots are node 0 and its nextSibling chain.
+		std::vector<ProfileNode> tree;
+	};
+
+	struct ProfileFrame
+	{
+		uint64_t index = 0;
+		int64_t startNs = 0;
+		int64_t endNs = 0;
+
+		/// @brief Zones lost because a thread's ring was full.
+		uint64_t droppedEvents = 0;
+
+		std::vector<ProfileThreadFrame> threads;
+	};
+
+	/// @brief Fills key/value pairs attached to every capture, e.g. scene statistics at the time of a hitch.
+	using ProfileMetadataProvider = std::function<void(std::vector<std::pair<std::string, std::string>>& metadata)>;
+
+	/// <summary>
+	/// Instrumentation profiler. Zones are written into a ring buffer owned by the recording thread,
+	/// so the hot path is two clock reads and an unshared store. EndFrame() drains every ring on the
+	/// main thread and rebuilds the call tree, off the hot path of the other threads.
+	/// Zone names are kept as pointers, they must outlive the frame they are recorded in.
+	/// </summary>
+	class Profiler
+	{
+	public:
+		static int64_t Now();
+
+		/// @brief Names the calling thread in the profiler output.
+		static void SetThreadName(const std::string& name);
+
+		static uint32_t PushZone();
+		static void PopZone(const char* name, int64_t startNs, uint32_t depth, const AllocationCounter& startAllocations);
+
+		/// @brief Collects the zones recorded since the last call. Main thread only.
+		static void EndFrame();
+
+		/// @brief Last completed frame. Main thread only, valid until the next EndFrame().
+		static const ProfileFrame& GetLastFrame();
+
+		/// @brief Records the next frameCount frames and writes them to path as Chrome Trace Event JSON,
+		/// one track per thread (open with chrome://tracing or ui.perfetto.dev). Main thread only.
+		/// The file is written by the EndFrame() that closes the capture. Zone names must stay alive until then.
+		/// An empty path writes ProfilerCapture_<frame>.json to the working directory.
+		static void BeginCapture(uint32_t frameCount, const filespace::filepath& path = {});
+		static bool IsCapturing();
+
+		/// @brief Frame count used by captures started from the editor.
+		static void SetCaptureFrameCount(uint32_t frameCount);
+		static uint32_t GetCaptureFrameCount();
+
+		/// @brief Keeps the zones of the last historyFrames frames in memory and writes them to
+		/// IAONNIS_PROFILER_HITCH_DIRECTORY/Hitch_<frame>.json whenever a frame takes longer than thresholdMs.
+		/// Off by default, a threshold of 0 disables the detector. After a dump the detector waits historyFrames frames
+		/// before it can trigger again, and it disables itself once IAONNIS_PROFILER_MAX_HITCH_CAPTURES were written.
+		static void SetHitchDetection(double thresholdMs, uint32_t historyFrames = 120);
+		static double GetHitchThreshold();
+		static uint32_t GetHitchCount();
+
+		static void SetMetadataProvider(ProfileMetadataProvider provider);
+	};
+
+	class ProfileZone
+	{
+	public:
+		explicit ProfileZone(const char* name)
+			:name(name), depth(Profiler::PushZone()), startAllocations(MemoryTracker::GetThreadAllocations()), startNs(Profiler::Now()) {}
+
+		~ProfileZone() { Profiler::PopZone(name, startNs, depth, startAllocations); }
+
+		ProfileZone(const ProfileZone&) = delete;
+		ProfileZone& operator=(const ProfileZone&) = delete;
+
+	private:
+		const char* name;
+		uint32_t depth;
+		AllocationCounter startAllocations;
+		int64_t startNs;
+	};
+
+#define IAONNIS_PROFILE_CONCAT_IMPL(a, b) a##b
+#define IAONNIS_PROFILE_CONCAT(a, b) IAONNIS_PROFILE_CONCAT_IMPL(a, b)
+
+#if IAONNIS_PROFILER_ENABLED
+#define IAONNIS_PROFILE_SCOPE(name) ::Iaonnis::ProfileZone IAONNIS_PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define IAONNIS_PROFILE_FUNCTION() IAONNIS_PROFILE_SCOPE(__FUNCTION__)
+#define IAONNIS_PROFILE_THREAD(name) ::Iaonnis::Profiler::SetThreadName(name)
+#else
+#define IAONNIS_PROFILE_SCOPE(name) ((void)0)
+#define IAONNIS_PROFILE_FUNCTION() ((void)0)
+#define IAONNIS_PROFILE_THREAD(name) ((void)0)
+#endif
+}
@@ -1,3 +0,0 @@
-#include "SimpleTimer.h"
-
-bool ScopedTimer::print_ = false;
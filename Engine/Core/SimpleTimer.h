@@ -16,11 +16,6 @@
 #define STIMER_PRINT(name) \
     std::cout << #name << ": " << format_duration((name).durationMs()) << std::endl
 
-// Scoped timer (auto prints when scope ends)
-#define SCOPE_TIMER(label) ScopedTimer timer_##__LINE__(label)
-#define ENABLE_SCOPE_TIMER_PRINT ScopedTimer::print_ = true;
-#define DISABLE_SCOPE_TIMER_PRINT ScopedTimer::print_ = false;
-
 
     using Clock = std::chrono::steady_clock;
     using TimePoint = Clock::time_point;
@@ -92,29 +87,4 @@
     };
 
 
-    // ---------------- ScopedTimer ----------------
-    // Automatically measures a scope duration and prints on destruction
-    class ScopedTimer {
-    public:
-        explicit ScopedTimer(const std::string& label = "")
-            : label_(label), start_(Clock::now()) {
-        }
-
-        ~ScopedTimer() {
-            if (print_) {
-                auto end = Clock::now();
-                double ms = std::chrono::duration<double, std::milli>(end - start_).count();
-                std::cout << (label_.empty() ? "ScopedTimer" : label_)
-                    << ": " << format_duration(ms) << std::endl;
-            }
-        }
-
-        static bool print_;
-
-    private:
-        std::string label_;
-
-        TimePoint start_;
-    };
-
 #endif 
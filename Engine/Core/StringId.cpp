@@ -0,0 +1,138 @@
+#include "StringId.h"
+#include "Defines.h"
+
+#include <shared_mutex>
+
+namespace Iaonnis {
+
+#define IAONNIS_STRING_TABLE_CHUNK_SIZE 1024
+#define IAONNIS_STRING_TABLE_MAX_CHUNKS 4096
+
+	namespace {
+
+		struct StringEntry
+		{
+			std::string string;
+			uint64_t hash = 0;
+		};
+
+		uint64_t HashString(std::string_view string)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (char c : string)
+			{
+				hash ^= (uint8_t)c;
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		struct StringViewHash
+		{
+			size_t operator()(std::string_view string)const { return (size_t)HashString(string); }
+		};
+
+		/// Entries sit in chunks that never move, so an id can be resolved without taking the lock.
+		/// The lookup map keys are views into those entries.
+		struct StringTable
+		{
+			std::shared_mutex mutex;
+			std::unordered_map<std::string_view, uint32_t, StringViewHash> lookup;
+			std::atomic<StringEntry*> chunks[IAONNIS_STRING_TABLE_MAX_CHUNKS] = {};
+			std::atomic<uint32_t> count{ 0 };
+
+			StringTable()
+			{
+				chunks[0].store(new StringEntry[IAONNIS_STRING_TABLE_CHUNK_SIZE], std::memory_order_relaxed);
+				chunks[0].load(std::memory_order_relaxed)[0].hash = HashString({});
+				lookup.emplace(std::string_view(), 0);
+				count.store(1, std::memory_order_release);
+			}
+
+			~StringTable()
+			{
+				for (auto& chunk : chunks)
+					delete[] chunk.load(std::memory_order_relaxed);
+			}
+
+			StringEntry& GetEntry(uint32_t id)
+			{
+				return chunks[id / IAONNIS_STRING_TABLE_CHUNK_SIZE].load(std::memory_order_acquire)[id % IAONNIS_STRING_TABLE_CHUNK_SIZE];
+			}
+		};
+
+		StringTable& GetTable()
+		{
+			static StringTable table;
+			return table;
+		}
+	}
+
+	StringId::StringId(std::string_view string)
+	{
+		StringTable& table = GetTable();
+
+		{
+			std::shared_lock<std::shared_mutex> lock(table.mutex);
+			auto it = table.lookup.find(string);
+			if (it != table.lookup.end())
+			{
+				id = it->second;
+				return;
+			}
+		}
+
+		std::unique_lock<std::shared_mutex> lock(table.mutex);
+
+		//Another thread may have added it between the two locks.
+		auto it = table.lookup.find(string);
+		if (it != table.lookup.end())
+		{
+			id = it->second;
+			return;
+		}
+
+		uint32_t newId = table.count.load(std::memory_order_relaxed);
+		IAONNIS_ASSERT(newId < IAONNIS_STRING_TABLE_CHUNK_SIZE * IAONNIS_STRING_TABLE_MAX_CHUNKS, "String table is full.");
+
+		auto& chunk = table.chunks[newId / IAONNIS_STRING_TABLE_CHUNK_SIZE];
+		if (!chunk.load(std::memory_order_relaxed))
+			chunk.store(new StringEntry[IAONNIS_STRING_TABLE_CHUNK_SIZE], std::memory_order_release);
+
+		StringEntry& entry = table.GetEntry(newId);
+		entry.string = string;
+		entry.hash = HashString(string);
+
+		table.lookup.emplace(std::string_view(entry.string), newId);
+		table.count.store(newId + 1, std::memory_order_release);
+
+		id = newId;
+	}
+
+	StringId StringId::Find(std::string_view string)
+	{
+		StringTable& table = GetTable();
+
+		std::shared_lock<std::shared_mutex> lock(table.mutex);
+		auto it = table.lookup.find(string);
+		if (it == table.lookup.end())
+			return StringId();
+
+		return StringId(it->second);
+	}
+
+	const std::string& StringId::str()const
+	{
+		return GetTable().GetEntry(id).string;
+	}
+
+	uint64_t StringId::GetHash()const
+	{
+		return GetTable().GetEntry(id).hash;
+	}
+
+	size_t StringId::GetInternedCount()
+	{
+		return GetTable().count.load(std::memory_order_acquire);
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "pch.h"
+
+namespace Iaonnis {
+
+	/// <summary>
+	/// 32 bit handle to a string in the global intern table.
+	/// Equal strings always get the same id, so comparing two StringIds is an integer compare.
+	/// Interned strings are never freed, which keeps every reference returned by str() valid for the lifetime of the program.
+	/// </summary>
+	class StringId
+	{
+	public:
+		/// @brief The empty string, id 0.
+		StringId() = default;
+
+		/// @brief Interns string, adding it to the table the first time it is seen. Safe to call from any thread.
+		explicit StringId(std::string_view string);
+
+		/// @brief Looks string up without adding it. Returns the empty id when it was never interned.
+		static StringId Find(std::string_view string);
+
+		uint32_t GetId()const { return id; }
+		bool IsValid()const { return id != 0; }
+
+		const std::string& str()const;
+		const char* c_str()const { return str().c_str(); }
+
+		/// @brief 64 bit FNV-1a hash of the string, computed once when it was interned.
+		uint64_t GetHash()const;
+
+		bool operator==(const StringId& other)const { return id == other.id; }
+		bool operator!=(const StringId& other)const { return id != other.id; }
+
+		/// @brief Number of distinct strings interned so far, including the empty string.
+		static size_t GetInternedCount();
+
+	private:
+		explicit StringId(uint32_t id) :id(id) {}
+
+	private:
+		uint32_t id = 0;
+	};
+}
+
+namespace std {
+	template<>
+	struct hash<Iaonnis::StringId>
+	{
+		size_t operator()(const Iaonnis::StringId& stringId)const noexcept
+		{
+			return hash<uint32_t>()(stringId.GetId());
+		}
+	};
+}
@@ -0,0 +1,210 @@
+#pragma once
+#include "pch.h"
+#include "Job.h"
+#include "IO.h"
+
+#include <coroutine>
+#include <optional>
+
+namespace Iaonnis {
+
+	template<class T>
+	class Task;
+
+	namespace Detail {
+
+		struct TaskPromiseBase
+		{
+			std::coroutine_handle<> continuation;
+
+			struct FinalAwaiter
+			{
+				bool await_ready()const noexcept { return false; }
+
+				template<class Promise>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle)noexcept
+				{
+					std::coroutine_handle<> next = handle.promise().continuation;
+					return next ? next : std::noop_coroutine();
+				}
+
+				void await_resume()const noexcept {}
+			};
+
+			std::suspend_always initial_suspend()const noexcept { return {}; }
+			FinalAwaiter final_suspend()const noexcept { return {}; }
+			void unhandled_exception()const noexcept { std::terminate(); }
+		};
+
+		template<class T>
+		struct TaskPromise : TaskPromiseBase
+		{
+			std::optional<T> value;
+
+			Task<T> get_return_object();
+			void return_value(T result) { value.emplace(std::move(result)); }
+		};
+
+		template<>
+		struct TaskPromise<void> : TaskPromiseBase
+		{
+			Task<void> get_return_object();
+			void return_void()const {}
+		};
+	}
+
+	/// <summary>
+	/// Lazily started coroutine. Nothing runs until the task is awaited (or handed to Spawn),
+	/// the awaiting coroutine is resumed on whichever thread the task finished on.
+	/// </summary>
+	template<class T = void>
+	class Task
+	{
+	public:
+		using promise_type = Detail::TaskPromise<T>;
+
+		Task() = default;
+		explicit Task(std::coroutine_handle<promise_type> handle) :handle(handle) {}
+		Task(Task&& other)noexcept :handle(std::exchange(other.handle, nullptr)) {}
+		Task& operator=(Task&& other)noexcept
+		{
+			if (this != &other)
+			{
+				if (handle)
+					handle.destroy();
+				handle = std::exchange(other.handle, nullptr);
+			}
+			return *this;
+		}
+
+		Task(const Task&) = delete;
+		Task& operator=(const Task&) = delete;
+
+		~Task()
+		{
+			if (handle)
+				handle.destroy();
+		}
+
+		bool await_ready()const noexcept { return !handle || handle.done(); }
+
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting)noexcept
+		{
+			handle.promise().continuation = awaiting;
+			return handle;
+		}
+
+		T await_resume()
+		{
+			if constexpr (!std::is_void_v<T>)
+				return std::move(*handle.promise().value);
+		}
+
+	private:
+		std::coroutine_handle<promise_type> handle;
+	};
+
+	namespace Detail {
+
+		template<class T>
+		Task<T> TaskPromise<T>::get_return_object()
+		{
+			return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+		}
+
+		inline Task<void> TaskPromise<void>::get_return_object()
+		{
+			return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+		}
+
+		/// @brief Owns itself, the frame is freed as soon as the wrapped task completes.
+		struct DetachedTask
+		{
+			struct promise_type
+			{
+				DetachedTask get_return_object()const noexcept { return {}; }
+				std::suspend_never initial_suspend()const noexcept { return {}; }
+				std::suspend_never final_suspend()const noexcept { return {}; }
+				void return_void()const noexcept {}
+				void unhandled_exception()const noexcept { std::terminate(); }
+			};
+		};
+
+		inline DetachedTask RunDetached(Task<void> task)
+		{
+			co_await task;
+		}
+	}
+
+	/// @brief Starts the task on the calling thread and lets it run to completion on its own.
+	inline void Spawn(Task<void> task)
+	{
+		Detail::RunDetached(std::move(task));
+	}
+
+	class CancellationToken
+	{
+	public:
+		CancellationToken() = default;
+		explicit CancellationToken(std::shared_ptr<std::atomic<bool>> state) :state(std::move(state)) {}
+
+		/// @brief A default constructed token is never cancelled.
+		bool IsCancelled()const { return state && state->load(std::memory_order_acquire); }
+
+	private:
+		std::shared_ptr<std::atomic<bool>> state;
+	};
+
+	/// @brief Owned by whoever requested the work. Destroying the source cancels every token handed out.
+	class CancellationSource
+	{
+	public:
+		CancellationSource() :state(std::make_shared<std::atomic<bool>>(false)) {}
+		~CancellationSource() { Cancel(); }
+
+		CancellationSource(const CancellationSource&) = delete;
+		CancellationSource& operator=(const CancellationSource&) = delete;
+
+		void Cancel() { state->store(true, std::memory_order_release); }
+		CancellationToken GetToken()const { return CancellationToken(state); }
+
+	private:
+		std::shared_ptr<std::atomic<bool>> state;
+	};
+
+	/// @brief co_await ResumeOnWorker() continues the coroutine on a job system worker.
+	/// Continues inline when the job system is not running.
+	struct ResumeOnWorker
+	{
+		bool await_ready()const noexcept { return !JobSystem::IsInitialized(); }
+		void await_suspend(std::coroutine_handle<> handle)const { JobSystem::Schedule([handle]() { handle.resume(); }); }
+		void await_resume()const noexcept {}
+	};
+
+	/// @brief co_await ReadFileAwaiter(path) suspends until IOService read the whole file.
+	/// The coroutine continues on the I/O thread that completed the request.
+	struct ReadFileAwaiter
+	{
+		filespace::filepath path;
+		IOResult result;
+
+		explicit ReadFileAwaiter(filespace::filepath path) :path(std::move(path)) {}
+
+		bool await_ready()const noexcept { return false; }
+
+		void await_suspend(std::coroutine_handle<> handle)
+		{
+			IORequest request;
+			request.path = path;
+			request.callback = [this, handle](IOResult& completed)
+				{
+					result = std::move(completed);
+					handle.resume();
+				};
+
+			IOService::Submit(std::move(request));
+		}
+
+		IOResult await_resume() { return std::move(result); }
+	};
+}
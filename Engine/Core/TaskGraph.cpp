@@ -0,0 +1,186 @@
+#include "TaskGraph.h"
+#include "Log.h"
+#include "Defines.h"
+#include "Profiler.h"
+
+namespace Iaonnis {
+
+	static bool Overlaps(const std::vector<std::string>& a, const std::vector<std::string>& b)
+	{
+		for (auto& x : a)
+			for (auto& y : b)
+				if (x == y)
+					return true;
+		return false;
+	}
+
+	TaskGraph& TaskGraph::AddStage(const std::string& name, TaskAffinity affinity, std::initializer_list<std::string> reads,
+		std::initializer_list<std::string> writes, std::function<void()> function)
+	{
+		IAONNIS_ASSERT(!compiled, "Stages can not be added to a compiled task graph.");
+
+		Stage stage;
+		stage.name = name;
+		stage.affinity = affinity;
+		stage.reads = reads;
+		stage.writes = writes;
+		stage.function = std::move(function);
+		stages.push_back(std::move(stage));
+
+		return *this;
+	}
+
+	void TaskGraph::Compile()
+	{
+		uint32_t count = (uint32_t)stages.size();
+
+		for (uint32_t j = 0; j < count; j++)
+		{
+			Stage& later = stages[j];
+			for (uint32_t i = 0; i < j; i++)
+			{
+				Stage& earlier = stages[i];
+
+				bool conflict = Overlaps(later.reads, earlier.writes)
+					|| Overlaps(later.writes, earlier.writes)
+					|| Overlaps(later.writes, earlier.reads);
+
+				if (!conflict)
+					continue;
+
+				later.dependencies.push_back(i);
+				earlier.successors.push_back(j);
+			}
+		}
+
+		pendingDependencies = std::make_unique<std::atomic<int32_t>[]>(count);
+
+		report.stageNames.clear();
+		for (auto& stage : stages)
+			report.stageNames.push_back(stage.name.c_str());
+		report.stages.assign(count, {});
+		lastReport = report;
+
+		compiled = true;
+	}
+
+	void TaskGraph::Execute()
+	{
+		IAONNIS_ASSERT(compiled, "TaskGraph::Compile() must be called before Execute().");
+
+		uint32_t count = (uint32_t)stages.size();
+		if (count == 0)
+			return;
+
+		frameStart = std::chrono::steady_clock::now();
+
+		for (uint32_t i = 0; i < count; i++)
+			pendingDependencies[i].store((int32_t)stages[i].dependencies.size(), std::memory_order_relaxed);
+		remainingStages.store(count, std::memory_order_release);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (stages[i].dependencies.empty())
+				Dispatch(i);
+		}
+
+		//The main thread runs its own stages as they become ready and helps with worker stages otherwise.
+		while (remainingStages.load(std::memory_order_acquire) > 0)
+		{
+			uint32_t index = ~0u;
+			{
+				std::lock_guard<std::mutex> lock(mainThreadQueueMutex);
+				if (!mainThreadQueue.empty())
+				{
+					index = mainThreadQueue.back();
+					mainThreadQueue.pop_back();
+				}
+			}
+
+			if (index != ~0u)
+				RunStage(index);
+			else if (!JobSystem::RunPendingJob())
+				std::this_thread::yield();
+		}
+
+		report.frameTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+		BuildCriticalPath();
+
+		std::swap(report, lastReport);
+	}
+
+	void TaskGraph::Dispatch(uint32_t index)
+	{
+		if (stages[index].affinity == TaskAffinity::Any && JobSystem::IsInitialized())
+		{
+			JobSystem::Schedule([this, index]() { RunStage(index); });
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(mainThreadQueueMutex);
+		mainThreadQueue.push_back(index);
+	}
+
+	void TaskGraph::RunStage(uint32_t index)
+	{
+		Stage& stage = stages[index];
+
+		auto start = std::chrono::steady_clock::now();
+		if (stage.function)
+		{
+			IAONNIS_PROFILE_SCOPE(stage.name.c_str());
+			stage.function();
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		TaskStageTiming& timing = report.stages[index];
+		timing.startMs = std::chrono::duration<double, std::milli>(start - frameStart).count();
+		timing.durationMs = std::chrono::duration<double, std::milli>(end - start).count();
+		timing.threadIndex = JobSystem::GetThreadIndex();
+
+		for (uint32_t successor : stage.successors)
+		{
+			if (pendingDependencies[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+				Dispatch(successor);
+		}
+
+		remainingStages.fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+	void TaskGraph::BuildCriticalPath()
+	{
+		//Walk back from the stage that finished last, always following the dependency that finished last.
+		//That dependency is the one the stage actually waited on.
+		auto finishTime = [this](uint32_t i) { return report.stages[i].startMs + report.stages[i].durationMs; };
+
+		uint32_t current = 0;
+		for (uint32_t i = 1; i < (uint32_t)stages.size(); i++)
+		{
+			if (finishTime(i) > finishTime(current))
+				current = i;
+		}
+
+		report.criticalPath.clear();
+		report.criticalPathMs = 0;
+
+		while (true)
+		{
+			report.criticalPath.push_back(current);
+			report.criticalPathMs += report.stages[current].durationMs;
+
+			auto& dependencies = stages[current].dependencies;
+			if (dependencies.empty())
+				break;
+
+			uint32_t gate = dependencies[0];
+			for (uint32_t dependency : dependencies)
+			{
+				if (finishTime(dependency) > finishTime(gate))
+					gate = dependency;
+			}
+			current = gate;
+		}
+
+		std::reverse(report.criticalPath.begin(), report.criticalPath.end());
+	}
+}
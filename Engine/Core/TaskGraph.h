@@ -0,0 +1,88 @@
+#pragma once
+#include "pch.h"
+#include "Job.h"
+
+#include <atomic>
+
+namespace Iaonnis {
+
+	enum class TaskAffinity
+	{
+		Any,		//Runs on whichever worker picks it up.
+		MainThread, //Touches the GL context or ImGui, runs on the thread calling Execute().
+	};
+
+	struct TaskStageTiming
+	{
+		double startMs = 0;		//Relative to the start of the frame.
+		double durationMs = 0;
+		uint32_t threadIndex = 0;
+	};
+
+	struct TaskGraphReport
+	{
+		double frameTimeMs = 0;
+
+		/// @brief Sum of the stage durations on the critical path. frameTimeMs - criticalPathMs is time lost to scheduling.
+		double criticalPathMs = 0;
+
+		std::vector<const char*> stageNames;
+		std::vector<TaskStageTiming> stages;
+
+		/// @brief Stage indices from the first to the last stage of the chain that bounded the frame.
+		std::vector<uint32_t> criticalPath;
+	};
+
+	/// @brief Declarative per-frame stage graph.
+	/// Stages name the data they read and write. Compile() orders every pair of stages that touch the same data
+	/// (read after write, write after read, write after write) in the order they were added, everything else may overlap.
+	class TaskGraph
+	{
+	public:
+		TaskGraph() = default;
+		TaskGraph(const TaskGraph&) = delete;
+		TaskGraph& operator=(const TaskGraph&) = delete;
+
+		TaskGraph& AddStage(const std::string& name, TaskAffinity affinity, std::initializer_list<std::string> reads,
+			std::initializer_list<std::string> writes, std::function<void()> function);
+
+		/// @brief Resolves stage dependencies. Must be called after the last AddStage() and before Execute().
+		void Compile();
+
+		/// @brief Runs every stage once and blocks until all have finished. Call from the main thread.
+		void Execute();
+
+		/// @brief Report of the last completed Execute(). Safe to read from inside a stage.
+		const TaskGraphReport& GetLastReport()const { return lastReport; }
+
+	private:
+		struct Stage
+		{
+			std::string name;
+			TaskAffinity affinity;
+			std::vector<std::string> reads;
+			std::vector<std::string> writes;
+			std::function<void()> function;
+
+			std::vector<uint32_t> dependencies;
+			std::vector<uint32_t> successors;
+		};
+
+		void Dispatch(uint32_t index);
+		void RunStage(uint32_t index);
+		void BuildCriticalPath();
+
+	private:
+		std::vector<Stage> stages;
+		std::unique_ptr<std::atomic<int32_t>[]> pendingDependencies;
+		std::atomic<uint32_t> remainingStages{ 0 };
+
+		std::mutex mainThreadQueueMutex;
+		std::vector<uint32_t> mainThreadQueue;
+
+		std::chrono::steady_clock::time_point frameStart;
+		TaskGraphReport report;
+		TaskGraphReport lastReport;
+		bool compiled = false;
+	};
+}
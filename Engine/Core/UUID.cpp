@@ -1,71 +1,251 @@
 #include "uuid.h"
+#include "Log.h"
 
 namespace Iaonnis {
-    UUID UUIDFactory::invalid{ 0,0 };
-    UUID UUIDFactory::generateUUID()
-    {
-        std::random_device rd;
-        std::mt19937_64 gen(rd());
-        std::uniform_int_distribution<uint64_t> dis(0, 0xFFFFFFFFFFFFFFFF);
 
-        UUID uuid;
-        uuid.high = dis(gen);
-        uuid.low = dis(gen);
+    namespace {
 
-        uuid.high &= 0xFFFFFFFFFFFF0FFFULL;
-        uuid.high |= 0x0000000000004000ULL;
+        constexpr char HexDigits[] = "0123456789abcdef";
 
-        uuid.low &= 0x3FFFFFFFFFFFFFFFULL;
-        uuid.low |= 0x8000000000000000ULL;
+        struct HexTable
+        {
+            int8_t values[256];
 
-        return uuid;
+            constexpr HexTable()
+                :values()
+            {
+                for (int i = 0; i < 256; i++)
+                    values[i] = -1;
+                for (int i = 0; i < 10; i++)
+                    values['0' + i] = (int8_t)i;
+                for (int i = 0; i < 6; i++)
+                {
+                    values['a' + i] = (int8_t)(10 + i);
+                    values['A' + i] = (int8_t)(10 + i);
+                }
+            }
+        };
+
+        constexpr HexTable HexValues;
+
+        //xoshiro256**, one per thread. Far smaller and faster than mt19937_64 and seeded once instead of per id.
+        struct UUIDGenerator
+        {
+            uint64_t state[4];
+
+            UUIDGenerator()
+            {
+                std::random_device rd;
+                for (uint64_t& word : state)
+                    word = ((uint64_t)rd() << 32) | rd();
+
+                if ((state[0] | state[1] | state[2] | state[3]) == 0)
+                    state[0] = 0x9E3779B97F4A7C15ULL;
+            }
+
+            static uint64_t Rotate(uint64_t x, int k)
+            {
+                return (x << k) | (x >> (64 - k));
+            }
+
+            uint64_t Next()
+            {
+                uint64_t result = Rotate(state[1] * 5, 7) * 9;
+                uint64_t t = state[1] << 17;
+
+                state[2] ^= state[0];
+                state[3] ^= state[1];
+                state[1] ^= state[2];
+                state[0] ^= state[3];
+                state[2] ^= t;
+                state[3] = Rotate(state[3], 45);
+
+                return result;
+            }
+
+            UUID Generate()
+            {
+                UUID uuid;
+                uuid.high = Next();
+                uuid.low = Next();
+
+                uuid.high &= 0xFFFFFFFFFFFF0FFFULL;
+                uuid.high |= 0x0000000000004000ULL;
+
+                uuid.low &= 0x3FFFFFFFFFFFFFFFULL;
+                uuid.low |= 0x8000000000000000ULL;
+
+                return uuid;
+            }
+        };
+
+        //Written once the benchmark is done so its loops cannot be optimized out.
+        volatile uint64_t BenchmarkSink = 0;
+
+        UUIDGenerator& GetGenerator()
+        {
+            thread_local UUIDGenerator generator;
+            return generator;
+        }
+
+        char* WriteHex(char* out, uint64_t value, int digits)
+        {
+            for (int i = digits - 1; i >= 0; i--)
+            {
+                out[i] = HexDigits[value & 0xF];
+                value >>= 4;
+            }
+            return out + digits;
+        }
+
+        template <typename Function>
+        double NanosecondsPer(uint32_t iterations, Function&& function)
+        {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            auto end = std::chrono::steady_clock::now();
+            return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        }
     }
 
-    std::string UUIDFactory::uuidToString(const UUID& uuid)
+    UUID UUIDFactory::invalid{ 0,0 };
+    UUID UUIDFactory::generateUUID()
     {
-        std::stringstream ss;
-        ss << std::hex << std::setfill('0');
+        return GetGenerator().Generate();
+    }
+
+    void UUIDFactory::generateUUIDs(UUID* uuids, size_t count)
+    {
+        UUIDGenerator& generator = GetGenerator();
+        for (size_t i = 0; i < count; i++)
+            uuids[i] = generator.Generate();
+    }
 
+    void UUIDFactory::uuidToChars(const UUID& uuid, char (&buffer)[IAONNIS_UUID_STRING_SIZE])
+    {
         uint64_t h = uuid.high;
         uint64_t l = uuid.low;
 
-        ss << std::setw(8) << ((h >> 32) & 0xFFFFFFFF) << "-";
-        ss << std::setw(4) << ((h >> 16) & 0xFFFF) << "-";
-        ss << std::setw(4) << (h & 0xFFFF) << "-";
-        ss << std::setw(4) << ((l >> 48) & 0xFFFF) << "-";
-        ss << std::setw(12) << (l & 0xFFFFFFFFFFFFULL);
-
-        return ss.str();
+        char* out = buffer;
+        out = WriteHex(out, h >> 32, 8);
+        *out++ = '-';
+        out = WriteHex(out, h >> 16, 4);
+        *out++ = '-';
+        out = WriteHex(out, h, 4);
+        *out++ = '-';
+        out = WriteHex(out, l >> 48, 4);
+        *out++ = '-';
+        out = WriteHex(out, l, 12);
+        *out = '\0';
     }
 
-    std::string removeHyphens(const std::string& s)
+    std::string UUIDFactory::uuidToString(const UUID& uuid)
     {
-        std::string result;
-        std::copy_if(s.begin(), s.end(), std::back_inserter(result),
-            [](char c) { return c != '-'; });
-        return result;
+        char buffer[IAONNIS_UUID_STRING_SIZE];
+        uuidToChars(uuid, buffer);
+        return std::string(buffer, IAONNIS_UUID_STRING_SIZE - 1);
     }
 
-    uint64_t hexToUint64(const std::string& hex)
+    bool UUIDFactory::tryParseUUID(std::string_view s, UUID& uuid)
     {
-        uint64_t value = 0;
-        std::stringstream ss;
-        ss << std::hex << hex;
-        ss >> value;
-        return value;
+        uint64_t words[2] = {};
+        int digits = 0;
+
+        for (char c : s)
+        {
+            if (c == '-')
+                continue;
+
+            int8_t value = HexValues.values[(uint8_t)c];
+            if (value < 0 || digits == 32)
+                return false;
+
+            uint64_t& word = words[digits / 16];
+            word = (word << 4) | (uint64_t)value;
+            digits++;
+        }
+
+        if (digits != 32)
+            return false;
+
+        uuid.high = words[0];
+        uuid.low = words[1];
+        return true;
     }
 
-    UUID UUIDFactory::uuidFromString(const std::string& s)
+    UUID UUIDFactory::uuidFromString(std::string_view s)
     {
-        std::string hex = removeHyphens(s);
-        if (hex.size() != 32)
+        UUID uuid;
+        if (!tryParseUUID(s, uuid))
         {
             throw std::runtime_error("Invalid UUID string");
         }
-
-        UUID uuid;
-        uuid.high = hexToUint64(hex.substr(0, 16));
-        uuid.low = hexToUint64(hex.substr(16, 16));
         return uuid;
     }
-}
\ No newline at end of file
+
+    void UUIDFactory::RunBenchmark(uint32_t iterations)
+    {
+        if (iterations == 0)
+            return;
+
+        std::vector<UUID> uuids(iterations);
+        std::vector<char> strings((size_t)iterations * IAONNIS_UUID_STRING_SIZE);
+        uint64_t sink = 0;
+
+        double generate = NanosecondsPer(iterations, [&]()
+            {
+                for (UUID& uuid : uuids)
+                    uuid = generateUUID();
+            });
+
+        double generateBulk = NanosecondsPer(iterations, [&]()
+            {
+                generateUUIDs(uuids.data(), uuids.size());
+            });
+
+        double hash = NanosecondsPer(iterations, [&]()
+            {
+                for (const UUID& uuid : uuids)
+                    sink += HashUUID(uuid);
+            });
+
+        //Sequential ids are the case a weak hash clusters on.
+        std::unordered_map<UUID, uint32_t> map;
+        map.reserve(iterations);
+        double mapInsert = NanosecondsPer(iterations, [&]()
+            {
+                for (uint32_t i = 0; i < iterations; i++)
+                    map.emplace(UUID{ i, i }, i);
+            });
+
+        double mapFind = NanosecondsPer(iterations, [&]()
+            {
+                for (uint32_t i = 0; i < iterations; i++)
+                    sink += map.find(UUID{ i, i })->second;
+            });
+
+        double format = NanosecondsPer(iterations, [&]()
+            {
+                for (uint32_t i = 0; i < iterations; i++)
+                    uuidToChars(uuids[i], *reinterpret_cast<char(*)[IAONNIS_UUID_STRING_SIZE]>(&strings[(size_t)i * IAONNIS_UUID_STRING_SIZE]));
+            });
+
+        bool roundTrip = true;
+        double parse = NanosecondsPer(iterations, [&]()
+            {
+                for (uint32_t i = 0; i < iterations; i++)
+                {
+                    UUID parsed;
+                    roundTrip &= tryParseUUID(std::string_view(&strings[(size_t)i * IAONNIS_UUID_STRING_SIZE], IAONNIS_UUID_STRING_SIZE - 1), parsed) && parsed == uuids[i];
+                }
+            });
+
+        IAONNIS_LOG_INFO("UUID benchmark over %u ids (ns per id). Generate: %.1f, Generate bulk: %.1f, Hash: %.2f, Map insert: %.1f, Map find: %.1f, Format: %.1f, Parse: %.1f",
+            iterations, generate, generateBulk, hash, mapInsert, mapFind, format, parse);
+
+        if (!roundTrip)
+            IAONNIS_LOG_ERROR("UUID benchmark: formatted ids did not parse back to the same ids.");
+
+        BenchmarkSink = sink;
+    }
+}
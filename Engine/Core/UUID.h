@@ -2,6 +2,10 @@
 #include "pch.h"
 
 namespace Iaonnis {
+
+	//Characters of a formatted UUID (8-4-4-4-12 hex digits) plus the terminating null.
+#define IAONNIS_UUID_STRING_SIZE 37
+
 	struct UUID
 	{
 		uint64_t high;
@@ -23,13 +27,43 @@ namespace Iaonnis {
 		}
 	};
 
+	/// @brief Folds the 128 bits into 64 with full avalanche (CityHash's Hash128to64), random and sequential ids spread alike.
+	inline uint64_t HashUUID(const UUID& uuid)
+	{
+		constexpr uint64_t multiplier = 0x9DDFEA08EB382D69ULL;
+		uint64_t a = (uuid.low ^ uuid.high) * multiplier;
+		a ^= (a >> 47);
+		uint64_t b = (uuid.high ^ a) * multiplier;
+		b ^= (b >> 47);
+		return b * multiplier;
+	}
+
+	/// <summary>
+	/// Random (version 4) UUIDs. Each thread owns a generator seeded once from std::random_device, so generating
+	/// takes no lock and does not touch the OS. Formatting and parsing are table driven; the char buffer overloads
+	/// do not allocate and are the ones to use per item per frame.
+	/// </summary>
 	class UUIDFactory
 	{
 	public:
 		static UUID generateUUID();
+
+		/// @brief Fills uuids with count new ids.
+		static void generateUUIDs(UUID* uuids, size_t count);
+
+		/// @brief Writes the 8-4-4-4-12 form and a terminating null to buffer.
+		static void uuidToChars(const UUID& uuid, char (&buffer)[IAONNIS_UUID_STRING_SIZE]);
 		static std::string uuidToString(const UUID& uuid);
-		static UUID uuidFromString(const std::string& s);
+
+		/// @brief Parses 32 hex digits, hyphens anywhere are skipped. Returns false and leaves uuid untouched otherwise.
+		static bool tryParseUUID(std::string_view s, UUID& uuid);
+
+		/// @brief Throws std::runtime_error when s is not a UUID.
+		static UUID uuidFromString(std::string_view s);
 		static UUID getInvalidUUID() { return invalid; }
+
+		/// @brief Times generation, hashing, formatting and parsing over iterations ids and logs the cost per id.
+		static void RunBenchmark(uint32_t iterations);
 	private:
 		static UUID invalid;
 	};
@@ -41,8 +75,7 @@ namespace std
 	{
 		std::size_t operator()(const Iaonnis::UUID& uuid) const noexcept
 		{
-            // Combine the two 64-bit integers into one hash
-			return std::hash<uint64_t>{}(uuid.high) ^ (std::hash<uint64_t>{}(uuid.low) << 1);
+			return (std::size_t)Iaonnis::HashUUID(uuid);
 		}
 	};
 }
@@ -72,11 +72,11 @@ namespace Iaonnis
     //Docking Data
 
 
-    void Iaonnis::Editor::OnUpdate(Renderer3D::RendererStatistics stats, uint32_t r)
+    void Iaonnis::Editor::OnUpdate(Renderer3D::RendererStatistics stats, uint32_t r, const TaskGraphReport& frameReport)
     {
         renderOut = r;
         {
-            SCOPE_TIMER("DOCKING_INIT");
+            IAONNIS_PROFILE_SCOPE("DOCKING_INIT");
 
             ImGui_ImplOpenGL3_NewFrame();
             ImGui_ImplGlfw_NewFrame();
@@ -120,7 +120,7 @@ namespace Iaonnis
 
 #ifdef _DEBUG
 #endif 
-        DebugWindow(stats);
+        DebugWindow(stats, frameReport);
 
         menubar->OnUpdate();
 
@@ -128,10 +128,10 @@ namespace Iaonnis
         float dt = io.DeltaTime;
 
         {
-            SCOPE_TIMER("PANELS_ON_RENDER"); //5ms-6ms
+            IAONNIS_PROFILE_SCOPE("PANELS_ON_RENDER"); //5ms-6ms
             for (auto& panel : panels)
             {
-                SCOPE_TIMER(panel->GetName());
+                IAONNIS_PROFILE_SCOPE(panel->GetName().c_str());
                 panel->OnUpdate(dt);
             }
         }
@@ -160,14 +160,12 @@ namespace Iaonnis
 
     void Editor::SelectEntt(Entity* entt)
     {
-        SelectionData.selectedEntt = entt;
+        SelectionData.selectedEntt = entt ? *entt : Entity();
     }
 
     bool Editor::isEnttSelectionMade() 
     {
-        if (SelectionData.selectedEntt == nullptr)
-            return false;
-        return true;
+        return SelectionData.selectedEntt.IsValid();
     }
 
     void Iaonnis::Editor::Deselect()
@@ -188,11 +186,10 @@ namespace Iaonnis
         scene = std::make_shared<Scene>("Scene");
     }
 
-    void Editor::DebugWindow(Renderer3D::RendererStatistics stats)
+    void Editor::DebugWindow(Renderer3D::RendererStatistics stats, const TaskGraphReport& frameReport)
     {
-        SCOPE_TIMER("DEBUG WINDOW");
+        IAONNIS_PROFILE_SCOPE("DEBUG WINDOW");
 
-        ImGuiIO& io = ImGui::GetIO();
         ImGui::Begin("Debug", nullptr, ImGuiWindowFlags_NoDocking | ImGuiWindowFlags_NoResize);
 
         float contentRegionAvailableX = ImGui::GetContentRegionAvail().x;
@@ -200,13 +197,43 @@ namespace Iaonnis
         ImGui::PushStyleVar(ImGuiStyleVar_SeparatorTextAlign, ImVec2(0.5, 0.5));
         ImGui::SeparatorText("Frame Stats");
 
-        static float history[100];
-        static int offset = 0;
-        ImGuiEx::PlotLines("Frame Per Second", history, offset, 100, io.Framerate, ImVec2(0, 120), ImVec2(contentRegionAvailableX, 80));
+        //Channel 0 is the frame time, registered first by the application.
+        static std::vector<float> frameTimes;
+        static int statsWindow = 600;
+        if (FrameStats::GetChannelCount() > 0)
+        {
+            FrameStats::GetHistory(0, (uint32_t)statsWindow, frameTimes);
+            FramePercentiles frameTime = FrameStats::GetPercentiles(0, (uint32_t)statsWindow);
+
+            char overlay[64];
+            snprintf(overlay, sizeof(overlay), "Frame %.3f ms  p99 %.3f ms", frameTimes.empty() ? 0.0f : frameTimes.back(), frameTime.p99);
+            ImGui::PlotLines("##FrameTimes", frameTimes.data(), (int)frameTimes.size(), 0, overlay, 0.0f, (float)frameTime.max * 1.1f, ImVec2(contentRegionAvailableX, 80));
+        }
 
-        static float dtHistory[100];
-        static int dtOffset = 0;
-        ImGuiEx::PlotLines("Delta Time(ms)", dtHistory, dtOffset, 100, 1000 / io.Framerate, ImVec2(0, 120), ImVec2(contentRegionAvailableX, 80));
+        ImGui::SliderInt("Window (frames)", &statsWindow, 60, IAONNIS_FRAME_STATS_HISTORY);
+        if (ImGui::BeginTable("FrameStats", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+        {
+            ImGui::TableSetupColumn("Channel");
+            ImGui::TableSetupColumn("p50");
+            ImGui::TableSetupColumn("p95");
+            ImGui::TableSetupColumn("p99");
+            ImGui::TableSetupColumn("Max");
+            ImGui::TableHeadersRow();
+
+            for (uint32_t channel = 0; channel < FrameStats::GetChannelCount(); channel++)
+            {
+                FramePercentiles percentiles = FrameStats::GetPercentiles(channel, (uint32_t)statsWindow);
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(FrameStats::GetChannelName(channel).c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", percentiles.p50);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", percentiles.p95);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", percentiles.p99);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", percentiles.max);
+            }
+
+            ImGui::EndTable();
+        }
 
         ImGui::SeparatorText("Rendering");
         ImGui::Text("Draw Calls: %d", stats.nDrawCalls);
@@ -214,11 +241,128 @@ namespace Iaonnis
         ImGui::Text("Indices: %d", stats.nRenderedIndices);
 
         ImGui::SeparatorText("Memory");
-        ImGui::Text("Textures: %.3f MB", (float)stats.totalTextureBufferSize / (1024.0f * 1024.0f));
+        if (ImGui::BeginTable("MemoryTags", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+        {
+            ImGui::TableSetupColumn("Tag");
+            ImGui::TableSetupColumn("Live (KB)");
+            ImGui::TableSetupColumn("Blocks");
+            ImGui::TableSetupColumn("Peak (KB)");
+            ImGui::TableSetupColumn("Frame (KB / n)");
+            ImGui::TableSetupColumn("GPU (MB)");
+            ImGui::TableHeadersRow();
+
+            MemoryTagStats total;
+            for (int i = 0; i < (int)MemoryTag::Count; i++)
+            {
+                MemoryTagStats tagStats = MemoryTracker::GetStats((MemoryTag)i);
+                total.liveBytes += tagStats.liveBytes;
+                total.liveAllocations += tagStats.liveAllocations;
+                total.frameBytes += tagStats.frameBytes;
+                total.frameAllocations += tagStats.frameAllocations;
+                total.gpuBytes += tagStats.gpuBytes;
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(MemoryTracker::GetTagName((MemoryTag)i));
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", tagStats.liveBytes / 1024.0f);
+                ImGui::TableNextColumn(); ImGui::Text("%lld", (long long)tagStats.liveAllocations);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", tagStats.peakBytes / 1024.0f);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f / %lld", tagStats.frameBytes / 1024.0f, (long long)tagStats.frameAllocations);
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", tagStats.gpuBytes / (1024.0f * 1024.0f));
+            }
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted("Total");
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", total.liveBytes / 1024.0f);
+            ImGui::TableNextColumn(); ImGui::Text("%lld", (long long)total.liveAllocations);
+            ImGui::TableNextColumn(); ImGui::TextUnformatted("-");
+            ImGui::TableNextColumn(); ImGui::Text("%.1f / %lld", total.frameBytes / 1024.0f, (long long)total.frameAllocations);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", total.gpuBytes / (1024.0f * 1024.0f));
+
+            ImGui::EndTable();
+        }
+
+#if !IAONNIS_MEMORY_TRACKING
+        ImGui::TextDisabled("Heap tracking is disabled in this build (IAONNIS_MEMORY_TRACKING).");
+#endif
+        if (uint64_t violations = MemoryTracker::GetAllocationViolationCount())
+            ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Steady-state allocations: %llu", (unsigned long long)violations);
 
         ImGui::SeparatorText("Upload Times");
         ImGui::Text("Scene Upload: %.3f ms", stats.sceneUploadTime);
         ImGui::Text("Material Upload: %.3f ms", stats.materialUploadTime);
+        ImGui::Text("Light Upload: %.3f ms", stats.lightUploadTime);
+
+        ImGui::SeparatorText("Render Passes");
+        if (ImGui::BeginTable("RenderPasses", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+        {
+            ImGui::TableSetupColumn("Pass");
+            ImGui::TableSetupColumn("CPU (ms)");
+            ImGui::TableSetupColumn("GPU (ms)");
+            ImGui::TableHeadersRow();
+
+            for (int i = 0; i < (int)Renderer3D::RenderPass::Count; i++)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(Renderer3D::GetRenderPassName((Renderer3D::RenderPass)i));
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", stats.passTimings[i].cpuMs);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", stats.passTimings[i].gpuMs);
+            }
+
+            ImGui::EndTable();
+        }
+
+        ImGui::SeparatorText("GPU Commands");
+        ImGui::Text("Executed: %u (%.3f ms)", stats.gpuCommandsExecuted, stats.gpuCommandTime);
+        ImGui::Text("Pending: %zu", stats.gpuCommandsPending);
+
+        float gpuBudget = (float)GPUCommandQueue::GetFrameBudget();
+        if (ImGui::SliderFloat("Budget (ms)", &gpuBudget, 0.5f, 16.0f, "%.1f"))
+            GPUCommandQueue::SetFrameBudget(gpuBudget);
+
+        FrameAllocatorStats frameMemory = FrameAllocator::GetStats();
+        ImGui::SeparatorText("Frame Allocator");
+        ImGui::Text("Used: %.1f / %.1f KB (Peak %.1f KB)", frameMemory.used / 1024.0f, frameMemory.capacity / 1024.0f, frameMemory.peak / 1024.0f);
+        ImGui::Text("Overflow: %.1f KB", frameMemory.overflow / 1024.0f);
+
+        EventQueueStats queuedEvents = EventQueue::GetStats();
+        ImGui::SeparatorText("Event Queue");
+        ImGui::Text("Posted: %u  Coalesced: %u  Dispatched: %u", queuedEvents.posted, queuedEvents.coalesced, queuedEvents.dispatched);
+
+        ImGui::SeparatorText("Frame Graph");
+        ImGui::Text("Frame: %.3f ms  Critical Path: %.3f ms", frameReport.frameTimeMs, frameReport.criticalPathMs);
+        for (uint32_t index : frameReport.criticalPath)
+        {
+            auto& timing = frameReport.stages[index];
+            ImGui::Text("%s: %.3f ms (thread %u)", frameReport.stageNames[index], timing.durationMs, timing.threadIndex);
+        }
+
+        const ProfileFrame& profile = Profiler::GetLastFrame();
+        ImGui::SeparatorText("Profiler");
+        ImGui::Text("Frame %llu: %.3f ms", (unsigned long long)profile.index, (profile.endNs - profile.startNs) / 1e6);
+        if (profile.droppedEvents)
+            ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "Dropped zones: %llu", (unsigned long long)profile.droppedEvents);
+
+        float hitchThreshold = (float)Profiler::GetHitchThreshold();
+        if (ImGui::SliderFloat("Hitch Threshold (ms)", &hitchThreshold, 0.0f, 500.0f, "%.0f"))
+            Profiler::SetHitchDetection(hitchThreshold);
+        ImGui::Text("Hitches written: %u / %u", Profiler::GetHitchCount(), IAONNIS_PROFILER_MAX_HITCH_CAPTURES);
+
+        if (InputRecorder::IsReplaying())
+            ImGui::Text("Replaying input: frame %u / %u", InputRecorder::GetFrameIndex(), InputRecorder::GetFrameCount());
+        else if (InputRecorder::IsRecording())
+            ImGui::Text("Recording input: frame %u", InputRecorder::GetFrameIndex());
+
+        for (auto& thread : profile.threads)
+        {
+            if (thread.tree.empty())
+                continue;
+
+            if (ImGui::TreeNodeEx(thread.name.c_str(), ImGuiTreeNodeFlags_SpanAvailWidth))
+            {
+                ProfilerTree(thread.tree, 0);
+                ImGui::TreePop();
+            }
+        }
 
         ImGui::SeparatorEx(ImGuiSeparatorFlags_Vertical);
 
@@ -227,6 +371,30 @@ namespace Iaonnis
         ImGui::End();
     }
 
+    void Editor::ProfilerTree(const std::vector<ProfileNode>& tree, int32_t node)
+    {
+        for (; node != -1; node = tree[node].nextSibling)
+        {
+            const ProfileNode& zone = tree[node];
+
+            ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanAvailWidth;
+            if (zone.firstChild == -1)
+                flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+
+            bool open = ImGui::TreeNodeEx((void*)(intptr_t)node, flags, "%s  %.3f ms (self %.3f ms) x%u", zone.name, zone.totalMs, zone.selfMs, zone.calls);
+            if (zone.allocations)
+            {
+                ImGui::SameLine();
+                ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "%lld allocs / %.1f KB", (long long)zone.allocations, zone.allocatedBytes / 1024.0f);
+            }
+            if (open && zone.firstChild != -1)
+            {
+                ProfilerTree(tree, zone.firstChild);
+                ImGui::TreePop();
+            }
+        }
+    }
+
     void Editor::InitializeDefaultPanels()
     {
         menubar = std::make_unique<MenuBar>(this);
@@ -37,10 +37,10 @@ namespace Iaonnis
 	public:
 		Editor(GLFWwindow* window, std::shared_ptr<Scene> activeScene);
 
-		void OnUpdate(Renderer3D::RendererStatistics stats, uint32_t r);
+		void OnUpdate(Renderer3D::RendererStatistics stats, uint32_t r, const TaskGraphReport& frameReport);
 		void ShutDown();
 
-		Entity* getSelectedEntity() { return SelectionData.selectedEntt; }
+		Entity* getSelectedEntity() { return SelectionData.selectedEntt.IsValid() ? &SelectionData.selectedEntt : nullptr; }
 		void SelectEntt(Entity* entt);
 		bool isEnttSelectionMade();
 		SelectionType GetSelectionType() { return SelectionData.selectionType; }
@@ -60,7 +60,8 @@ namespace Iaonnis
 
 		uint32_t renderOut; //temp
 	private:
-		void DebugWindow(Renderer3D::RendererStatistics stats);
+		void DebugWindow(Renderer3D::RendererStatistics stats, const TaskGraphReport& frameReport);
+		void ProfilerTree(const std::vector<ProfileNode>& tree, int32_t node);
 
 		void InitializeDefaultPanels();
 
@@ -72,7 +73,7 @@ namespace Iaonnis
 		{
 			int selectionIndex = -1;
 			SelectionType selectionType = SelectionType::None;
-			Entity* selectedEntt = nullptr;
+			Entity selectedEntt;
 		}SelectionData;
 
 		ViewPortAction viewPortAction = ViewPortAction::Inactive;
@@ -16,7 +16,7 @@ namespace Iaonnis
 
 	void MenuBar::OnUpdate()
 	{
-		SCOPE_TIMER(__FUNCTION__);
+		IAONNIS_PROFILE_FUNCTION();
 
 		if(ImGui::BeginMainMenuBar())
 		{
@@ -77,6 +77,31 @@ namespace Iaonnis
 				ImGui::EndMenu();
 			}
 
+			if (ImGui::BeginMenu("Debug"))
+			{
+				if (ImGui::MenuItem("Capture Profiler Trace", "F9", false, !Profiler::IsCapturing()))
+				{
+					Profiler::BeginCapture(Profiler::GetCaptureFrameCount());
+				}
+
+				int frameCount = (int)Profiler::GetCaptureFrameCount();
+				if (ImGui::InputInt("Frames", &frameCount))
+				{
+					Profiler::SetCaptureFrameCount((uint32_t)std::max(frameCount, 1));
+				}
+
+				ImGui::Separator();
+				if (ImGui::MenuItem("Record Frame Stats CSV", nullptr, FrameStats::IsWritingCSV()))
+				{
+					if (FrameStats::IsWritingCSV())
+						FrameStats::CloseCSV();
+					else
+						FrameStats::OpenCSV("FrameStats_" + std::to_string(FrameStats::GetFrameCount()) + ".csv");
+				}
+
+				ImGui::EndMenu();
+			}
+
 			if (ImGui::BeginMenu("Help"))
 			{
 				if (ImGui::MenuItem("About Iaonnis"))
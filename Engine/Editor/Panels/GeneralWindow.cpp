@@ -18,6 +18,11 @@ namespace Iaonnis
 			std::string name = "Cache Viewer";
 			std::function<void(UUID id)> callback = nullptr;
 
+			//Handles of the cached textures, rebuilt only when the pool's version moves. The pool is locked just for that.
+			std::vector<ResourceHandle<ImageTexture>> thumbnails;
+			uint64_t thumbnailsVersion = 0;
+			const ResourceCache* thumbnailsCache = nullptr;
+
 			template<>
 			void OnRender<ImageTexture>()
 			{
@@ -26,8 +31,17 @@ namespace Iaonnis
 
 				ImGui::Begin(name.c_str(), &active);
 				auto cache = editor->getScene()->getCache();
-				
-				std::vector<std::shared_ptr<ImageTexture>> imageTextureCache = cache->getByType<ImageTexture>(ResourceType::ImageTexture);
+
+				uint64_t version = cache->GetVersion<ImageTexture>();
+				if (thumbnailsCache != cache.get() || thumbnailsVersion != version)
+				{
+					thumbnails.clear();
+					for (auto& imageTexture : cache->getByType<ImageTexture>())
+						thumbnails.push_back(imageTexture.GetHandle<ImageTexture>());
+
+					thumbnailsCache = cache.get();
+					thumbnailsVersion = version;
+				}
 				
 				static float thumbnailSize = 64;
 				static float padding = 6.0f;
@@ -46,38 +60,47 @@ namespace Iaonnis
 				ImGuiWindow* currentWindow = con->CurrentWindow;
 
 				static UUID selectedItem = UUIDFactory::getInvalidUUID();
-				for (auto& imageTexture : imageTextureCache)
+				UUID chosenItem = UUIDFactory::getInvalidUUID();
+				for (ResourceHandle<ImageTexture> handle : thumbnails)
 				{
-					std::string label = imageTexture->getName() + "##" + UUIDFactory::uuidToString(imageTexture->GetID());
+					ImageTexture* texture = cache->Get(handle);
+					if (!texture)
+						continue;
+
+					ImageTexture& imageTexture = *texture;
+
+					char label[IAONNIS_UUID_STRING_SIZE];
+					UUIDFactory::uuidToChars(imageTexture.GetID(), label);
 
 					//int flag = /*ImGuiButtonFlags_*/
 					bool clicked = false;
 
-					if (imageTexture->GetID() == selectedItem)
+					if (imageTexture.GetID() == selectedItem)
 					{
 						ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));
 						
-						ImGui::ImageButtonEx(currentWindow->GetID(label.c_str()), imageTexture->getTextureHandle().m_ID,
+						ImGui::ImageButtonEx(currentWindow->GetID(label), imageTexture.getTextureHandle().m_ID,
 							ImVec2(thumbnailSize, thumbnailSize), ImVec2(1, 0),
 							ImVec2(0, 1), ImVec4(0, 0, 0, 0), ImVec4(1, 1, 1, 1));
 
 						ImGui::PopStyleColor();
 					}
 					else {
-						ImGui::ImageButtonEx(currentWindow->GetID(label.c_str()), imageTexture->getTextureHandle().m_ID,
+						ImGui::ImageButtonEx(currentWindow->GetID(label), imageTexture.getTextureHandle().m_ID,
 							ImVec2(thumbnailSize, thumbnailSize), ImVec2(1, 0),
 							ImVec2(0, 1), ImVec4(0, 0, 0, 0), ImVec4(1, 1, 1, 1));
 					}
 					
 
+					if (ImGui::IsItemHovered())
+						ImGui::SetTooltip("%s\nGPU: %.2f MB", imageTexture.getName().c_str(), imageTexture.GetGPUMemoryEstimate() / (1024.0f * 1024.0f));
+
 					if (ImGui::IsItemHovered() && ImGui::IsMouseClicked(0))
-						selectedItem = imageTexture->GetID();
+						selectedItem = imageTexture.GetID();
 
 					if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(0))
 					{
-						
-						callback(imageTexture->GetID());
-						SetInactive();
+						chosenItem = imageTexture.GetID();
 						break;
 					}
 					ImGui::NextColumn();
@@ -85,6 +108,13 @@ namespace Iaonnis
 
 				ImGui::Columns(1);
 				ImGui::End();
+
+				//The callback may cache or load textures, so it runs with nothing of the cache held.
+				if (chosenItem != UUIDFactory::getInvalidUUID())
+				{
+					callback(chosenItem);
+					SetInactive();
+				}
 			}
 
 			void SetActive(std::function<void(UUID id)> callbak)
@@ -109,10 +109,12 @@ namespace Iaonnis
 			GeneralWindow::CacheViewer::SetActive([this, materialID, type](UUID id) -> void
 				{
 					auto mat = cache->GetByUUID<Material>(materialID);
-					if (mat) {
-						mat->SetMap(type, id);
-						editor->getScene()->OnMaterialModified();
-					}
+					auto texture = cache->GetByUUID<ImageTexture>(id);
+					if (!mat || !texture)
+						return;
+
+					mat->SetMap(type, texture);
+					editor->getScene()->OnMaterialModified();
 				});
 		}
 
@@ -123,7 +125,7 @@ namespace Iaonnis
 		if (ImGuiEx::Button("New", ImVec2(70, 20)))
 		{
 			auto duplicateResource = cache->duplicate<ImageTexture>(cache->GetDefaultByTextureType(type)->GetID());
-			material->SetMap(type, duplicateResource->GetID());
+			material->SetMap(type, duplicateResource);
 			editor->getScene()->OnMaterialModified();//OnMaterialModified
 		}
 		if (ImGuiEx::Button("Open", ImVec2(70, 20)))
@@ -137,7 +139,7 @@ namespace Iaonnis
 					IAONNIS_LOG_ERROR("No texture has been loaded");
 				}
 				else {
-					material->SetMap(type, loadedTexture->GetID());
+					material->SetMap(type, loadedTexture);
 					editor->getScene()->OnMaterialModified();//OnMaterialModified
 				}
 			}
@@ -145,7 +147,7 @@ namespace Iaonnis
 		if (ImGuiEx::Button("Remove", ImVec2(70, 20), ImDrawFlags_RoundCornersBottom))
 		{
 			auto defaultTexture = cache->GetDefaultByTextureType(type);
-			material->SetMap(type, defaultTexture->GetID());
+			material->SetMap(type, defaultTexture);
 			editor->getScene()->OnMaterialModified();//OnMaterialModified
 		}
 		ImGui::EndGroup();
@@ -159,11 +161,11 @@ namespace Iaonnis
 	{
 		if(ImGui::BeginPopup("##MaterialSelection"))
 		{
-			for (auto& mtl : cache->getByType<Material>(ResourceType::Material))
+			for (auto& mtl : cache->getByType<Material>())
 			{
-				if (ImGui::MenuItem(mtl->getName().c_str()))
+				if (ImGui::MenuItem(mtl.getName().c_str()))
 				{
-					scene->AssignMaterial(entt.GetUUID(), mtl->GetID(), index);
+					scene->AssignMaterial(entt.GetUUID(), mtl.GetID(), index);
 					editor->getScene()->OnEntityRegisteryModified();
 				}
 			}
@@ -172,11 +174,11 @@ namespace Iaonnis
 
 		if(ImGui::BeginPopup("##MaterialSelectionGlobal"))
 		{
-			for (auto& mtl : cache->getByType<Material>(ResourceType::Material))
+			for (auto& mtl : cache->getByType<Material>())
 			{
-				if (ImGui::MenuItem(mtl->getName().c_str()))
+				if (ImGui::MenuItem(mtl.getName().c_str()))
 				{
-					scene->AssigGlobalMaterial(entt.GetUUID(), mtl->GetID());
+					scene->AssigGlobalMaterial(entt.GetUUID(), mtl.GetID());
 					editor->getScene()->OnEntityRegisteryModified();
 				}
 			}
@@ -214,9 +216,14 @@ namespace Iaonnis
 
 		DrawComponent<TagComponent>("Entity", *entity, [&](auto& component)
 		{
-			if (ImGui::Checkbox(("##EntityActive" + UUIDFactory::uuidToString(entity->GetUUID())).c_str(), &entity->active))
+			char idString[IAONNIS_UUID_STRING_SIZE];
+			UUIDFactory::uuidToChars(entity->GetUUID(), idString);
+			ImGui::PushID(idString);
+			if (ImGui::Checkbox("##EntityActive", entity->GetActive()))
 			{
+				editor->getScene()->OnEntityRegisteryModified();
 			}
+			ImGui::PopID();
 			ImGui::SameLine();
 			ImGui::Text(component.tag.c_str());
 		});
@@ -237,10 +244,13 @@ namespace Iaonnis
 
 			const ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_FramePadding | ImGuiTreeNodeFlags_AllowItemOverlap | ImGuiTreeNodeFlags_Framed;
 
-			std::shared_ptr<Mesh> mesh = cache->GetByUUID<Mesh>(meshFilter.meshID);
+			Mesh* mesh = cache->Get(meshFilter.mesh);
+			if (mesh)
+				ImGui::Text("GPU: %.2f MB", mesh->GetGPUMemoryEstimate() / (1024.0f * 1024.0f));
+
 			if (ImGui::TreeNodeEx("Materials", flags))
 			{
-				for (auto& [mtlID, mtlDependants] : meshFilter.materialIDMap)
+				for (auto& [mtlID, mtlDependants] : entity->GetMaterialUsers())
 				{
 					std::shared_ptr<Material> material = cache->GetByUUID<Material>(mtlID);
 					std::string label = material->getName() + "##02301";
@@ -249,16 +259,16 @@ namespace Iaonnis
 						static int mtlListCurrentItem = 0;
 						if(ImGui::BeginListBox("##MtlDependantList",ImVec2(0,180)))
 						{
-							for (int i = 0; i < mtlDependants.size(); i++)
+							for (int subMeshIndex : mtlDependants)
 							{
 								float lineHeight = GImGui->Font->FontSize;
 								float padding = ImGuiEx::tightButtonPadding.x;
 
-								SubMesh* submesh = mesh->getSubMesh(i);
-								const bool isSelected = (mtlListCurrentItem == i);
+								SubMesh* submesh = mesh->getSubMesh(subMeshIndex);
+								const bool isSelected = (mtlListCurrentItem == subMeshIndex);
 								if (ImGui::Selectable(submesh->name.c_str(), isSelected))
 								{
-									mtlListCurrentItem = i;
+									mtlListCurrentItem = subMeshIndex;
 								}
 
 								if (isSelected)
@@ -323,7 +333,6 @@ namespace Iaonnis
 
 					
 				}
-				entity->DettachUnusedMaterials();
 				ImGui::TreePop();
 			}
 
@@ -395,7 +404,7 @@ namespace Iaonnis
 
 	void Inspector::OnUpdate(float dt)
 	{
-		SCOPE_TIMER(__FUNCTION__);
+		IAONNIS_PROFILE_FUNCTION();
 		scene = editor->getScene();
 		cache = scene->getCache().get();
 
@@ -10,7 +10,7 @@ namespace Iaonnis
 			EditorPanel(Editor* editor);
 			virtual ~EditorPanel();
 			
-			virtual std::string GetName() { return name; }
+			virtual const std::string& GetName() { return name; }
 
 			virtual void OnUpdate(float dt) = 0;
 
@@ -18,7 +18,7 @@ namespace Iaonnis
 
 	void SceneHierachy::OnUpdate(float dt)
 	{
-		SCOPE_TIMER(__FUNCTION__);
+		IAONNIS_PROFILE_FUNCTION();
 
 		if(ImGui::Begin(name.c_str(), &active, ImGuiWindowFlags_HorizontalScrollbar))
 		{
@@ -33,8 +33,7 @@ namespace Iaonnis
 			ImGui::Separator();
 
 			int index = 0;
-			auto& entts = editor->getScene()->GetEntities();
-			for (auto& entt : entts)
+			editor->getScene()->EachEntity([&](Entity entt)
 			{
 				int flag = ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_SpanAvailWidth;
 
@@ -45,7 +44,9 @@ namespace Iaonnis
 				}
 
 				auto tag = entt.GetTag();
-				if (ImGui::TreeNodeEx((tag + "##Parent" + UUIDFactory::uuidToString(entt.GetUUID())).c_str(),flag))
+				char idString[IAONNIS_UUID_STRING_SIZE];
+				UUIDFactory::uuidToChars(entt.GetUUID(), idString);
+				if (ImGui::TreeNodeEx(idString, flag, "%s", tag.c_str()))
 				{
 					if (ImGui::IsItemClicked(ImGuiMouseButton_Left))
 					{
@@ -91,7 +92,7 @@ namespace Iaonnis
 					}
 					ImGui::TreePop();
 				}
-			}
+			});
 
 			OnPopUpContext();
 			if (ImGui::IsWindowHovered() && ImGui::IsMouseClicked(0) && !ImGui::IsItemHovered())
@@ -118,28 +119,20 @@ namespace Iaonnis
 			{
 				if (ImGui::MenuItem("Custom Mesh"))
 				{
-					//Job
 					std::string meshPath = FileDialog::OpenFileDialog();
 					if (!meshPath.empty())
 					{
-						std::shared_ptr<Mesh> newResource = editor->getScene()->getCache()->load<Mesh>(meshPath);
-						if (!newResource)
-						{
-							IAONNIS_LOG_ERROR("Failed to custom mesh.");
-						}
-						else {
-							editor->getScene()->addMesh(newResource->GetID());
-						}
+						Spawn(editor->getScene()->addMeshAsync(meshPath));
 					}
 				}
 				if (ImGui::MenuItem("Cube"))
 				{
-					auto& newEntt = editor->getScene()->AddCube("Cube");
+					editor->getScene()->AddCube("Cube");
 					editor->Deselect();
 				}
 				if (ImGui::MenuItem("Plane"))
 				{
-					auto& newEntt = editor->getScene()->AddPlane("Plane");
+					editor->getScene()->AddPlane("Plane");
 					editor->Deselect();
 				}
 				ImGui::EndMenu();
@@ -149,17 +142,17 @@ namespace Iaonnis
 			{
 				if (ImGui::MenuItem("Directional Light"))
 				{
-					auto& newEntt = editor->getScene()->addDirectionalLight();
+					editor->getScene()->addDirectionalLight();
 					editor->Deselect();
 				}
 				if (ImGui::MenuItem("Point Light"))
 				{
-					auto& newEntt = editor->getScene()->AddPointLight();
+					editor->getScene()->AddPointLight();
 					editor->Deselect();
 				}
 				if (ImGui::MenuItem("Spot Light"))
 				{
-					auto& newEntt = editor->getScene()->addSpotLight();
+					editor->getScene()->addSpotLight();
 					editor->Deselect();
 				}
 				ImGui::EndMenu();
@@ -190,7 +183,8 @@ namespace Iaonnis
 			if (ImGui::MenuItem("Remove"))
 			{
 				Entity* entity = editor->getSelectedEntity();
-				editor->getScene()->RemoveEntity(*entity);
+				if (entity)
+					editor->getScene()->RemoveEntity(*entity);
 
 				editor->Deselect();
 			}
@@ -12,7 +12,7 @@ namespace Iaonnis
 
 	void ViewPort::OnUpdate(float dt)
 	{
-		SCOPE_TIMER(__FUNCTION__);
+		IAONNIS_PROFILE_FUNCTION();
 
 		ImGui::Begin(name.c_str(), &active);
 
@@ -24,7 +24,8 @@ namespace Iaonnis
 			frameResizeEvent.frameSizeX = viewPortSize.x;
 			frameResizeEvent.frameSizeY = viewPortSize.y;
 
-			EventBus::publish(frameResizeEvent);
+			//Dragging a splitter changes the size every frame, only the last size of a frame rebuilds the targets.
+			EventQueue::post(frameResizeEvent);
 		}
 
 		ImGui::Image(editor->renderOut, lastViewPortSize, ImVec2(0, 1), ImVec2(1, 0));
@@ -0,0 +1,95 @@
+#include "GPUCommandQueue.h"
+
+#include <limits>
+
+namespace Iaonnis {
+
+	std::mutex GPUCommandQueue::queueMutex;
+	std::deque<GPUCommand> GPUCommandQueue::commands;
+
+	std::thread::id GPUCommandQueue::glThread;
+	bool GPUCommandQueue::initialized = false;
+	double GPUCommandQueue::frameBudget = 4.0;
+
+	void GPUCommandQueue::Initialize(double frameBudgetMs)
+	{
+		glThread = std::this_thread::get_id();
+		frameBudget = frameBudgetMs;
+		initialized = true;
+	}
+
+	void GPUCommandQueue::Shutdown()
+	{
+		Flush();
+		initialized = false;
+	}
+
+	void GPUCommandQueue::Submit(GPUCommand command)
+	{
+		if (IsGLThread())
+		{
+			command();
+			return;
+		}
+
+		Enqueue(std::move(command));
+	}
+
+	void GPUCommandQueue::Enqueue(GPUCommand command)
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		commands.push_back(std::move(command));
+	}
+
+	GPUCommandQueueStats GPUCommandQueue::Execute(double budgetMs)
+	{
+		IAONNIS_ASSERT(IsGLThread(), "GPU commands must be executed on the GL thread.");
+		IAONNIS_PROFILE_SCOPE("GPUCommandQueue::Execute");
+
+		GPUCommandQueueStats stats;
+		auto start = std::chrono::steady_clock::now();
+
+		while (true)
+		{
+			GPUCommand command;
+			{
+				std::lock_guard<std::mutex> lock(queueMutex);
+				if (commands.empty())
+					break;
+
+				command = std::move(commands.front());
+				commands.pop_front();
+			}
+
+			{
+				IAONNIS_PROFILE_SCOPE("GPUCommand");
+				command();
+			}
+			stats.executedCommands++;
+
+			stats.executionTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			if (stats.executionTime >= budgetMs)
+				break;
+		}
+
+		stats.pendingCommands = GetPendingCount();
+		return stats;
+	}
+
+	void GPUCommandQueue::Flush()
+	{
+		while (GetPendingCount() > 0)
+			Execute(std::numeric_limits<double>::max());
+	}
+
+	size_t GPUCommandQueue::GetPendingCount()
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		return commands.size();
+	}
+
+	bool GPUCommandQueue::IsGLThread()
+	{
+		return !initialized || std::this_thread::get_id() == glThread;
+	}
+}
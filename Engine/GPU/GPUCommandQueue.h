@@ -0,0 +1,76 @@
+#pragma once
+#include "../Core/pch.h"
+#include "../Core/core.h"
+
+#include <deque>
+#include <coroutine>
+
+namespace Iaonnis {
+
+	using GPUCommand = std::function<void()>;
+
+	struct GPUCommandQueueStats
+	{
+		uint32_t executedCommands = 0;
+		size_t pendingCommands = 0;
+		double executionTime = 0; //ms
+	};
+
+	struct GLThreadAwaiter;
+
+	/// <summary>
+	/// Work that has to run on the thread owning the GL context.
+	/// Any thread may queue commands, the renderer drains them at the start of every frame within a time budget.
+	/// </summary>
+	class GPUCommandQueue
+	{
+	public:
+		/// @brief Marks the calling thread as the GL thread. Call once the context is current.
+		static void Initialize(double frameBudgetMs = 4.0);
+
+		/// @brief Runs every command still pending. Call on the GL thread before the context is destroyed.
+		static void Shutdown();
+
+		/// @brief Runs the command right away on the GL thread, queues it from any other thread.
+		static void Submit(GPUCommand command);
+
+		/// @brief Always queues, even on the GL thread. Use for work that should not stall the current frame.
+		static void Enqueue(GPUCommand command);
+
+		/// @brief Runs queued commands in order until budgetMs is used up.
+		/// At least one command runs per call so a single expensive command can not block the queue forever.
+		static GPUCommandQueueStats Execute(double budgetMs);
+		static GPUCommandQueueStats ExecuteFrame() { return Execute(frameBudget); }
+
+		static void Flush();
+
+		static void SetFrameBudget(double budgetMs) { frameBudget = budgetMs; }
+		static double GetFrameBudget() { return frameBudget; }
+
+		static size_t GetPendingCount();
+
+		/// @brief True on the GL thread, or on any thread before Initialize() was called.
+		static bool IsGLThread();
+
+		/// @brief co_await GPUCommandQueue::ResumeOnGLThread() continues the coroutine on the GL thread.
+		/// Commands enqueued earlier run first, so uploads queued by the coroutine are done once it resumes.
+		static GLThreadAwaiter ResumeOnGLThread();
+
+	private:
+		static std::mutex queueMutex;
+		static std::deque<GPUCommand> commands;
+
+		static std::thread::id glThread;
+		static bool initialized;
+		static double frameBudget;
+	};
+
+	struct GLThreadAwaiter
+	{
+		bool await_ready()const { return GPUCommandQueue::IsGLThread(); }
+		void await_suspend(std::coroutine_handle<> handle)const { GPUCommandQueue::Enqueue([handle]() { handle.resume(); }); }
+		void await_resume()const noexcept {}
+	};
+
+	inline GLThreadAwaiter GPUCommandQueue::ResumeOnGLThread() { return {}; }
+}
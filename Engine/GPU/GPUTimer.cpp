@@ -0,0 +1,76 @@
+#include "GPUTimer.h"
+
+namespace Iaonnis {
+
+	void TimingWindow::Add(double sample)
+	{
+		if (count == IAONNIS_GPU_TIMER_WINDOW)
+			sum -= samples[next];
+		else
+			count++;
+
+		samples[next] = sample;
+		sum += sample;
+		next = (next + 1) % IAONNIS_GPU_TIMER_WINDOW;
+	}
+
+	void GPUTimer::Create()
+	{
+		if (created)
+			return;
+
+		glGenQueries(IAONNIS_GPU_TIMER_LATENCY * 2, &queries[0][0]);
+		created = true;
+	}
+
+	void GPUTimer::Destroy()
+	{
+		if (!created)
+			return;
+
+		glDeleteQueries(IAONNIS_GPU_TIMER_LATENCY * 2, &queries[0][0]);
+		created = false;
+	}
+
+	void GPUTimer::Begin()
+	{
+		if (!created)
+			return;
+
+		Collect(current);
+
+		cpuStart = std::chrono::steady_clock::now();
+		glQueryCounter(queries[current][0], GL_TIMESTAMP);
+	}
+
+	void GPUTimer::End()
+	{
+		if (!created)
+			return;
+
+		glQueryCounter(queries[current][1], GL_TIMESTAMP);
+		cpuTime.Add(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cpuStart).count());
+
+		pending[current] = true;
+		current = (current + 1) % IAONNIS_GPU_TIMER_LATENCY;
+	}
+
+	void GPUTimer::Collect(uint32_t set)
+	{
+		if (!pending[set])
+			return;
+
+		pending[set] = false;
+
+		//The end query is issued last, if it is available the start one is too.
+		GLint available = GL_FALSE;
+		glGetQueryObjectiv(queries[set][1], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available)
+			return;
+
+		GLuint64 start = 0, end = 0;
+		glGetQueryObjectui64v(queries[set][0], GL_QUERY_RESULT, &start);
+		glGetQueryObjectui64v(queries[set][1], GL_QUERY_RESULT, &end);
+		gpuTime.Add((end - start) / 1e6);
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "../Core/pch.h"
+#include "../Core/core.h"
+
+namespace Iaonnis {
+
+	//Frames a query may stay in flight before its result is read. The CPU never waits on a query.
+#define IAONNIS_GPU_TIMER_LATENCY 3
+
+	//Samples averaged by GetGPUTimeMs()/GetCPUTimeMs().
+#define IAONNIS_GPU_TIMER_WINDOW 64
+
+	/// @brief Running average over the last IAONNIS_GPU_TIMER_WINDOW samples.
+	class TimingWindow
+	{
+	public:
+		void Add(double sample);
+		double GetAverage()const { return count ? sum / count : 0.0; }
+
+	private:
+		double samples[IAONNIS_GPU_TIMER_WINDOW] = {};
+		double sum = 0.0;
+		uint32_t next = 0;
+		uint32_t count = 0;
+	};
+
+	/// <summary>
+	/// Measures a block of GL commands with a pair of GL_TIMESTAMP queries, and the CPU time spent issuing them.
+	/// Every Begin()/End() pair uses the next of IAONNIS_GPU_TIMER_LATENCY query sets; before a set is reused
+	/// its result is read if the GPU has finished it and dropped otherwise, so nothing ever stalls.
+	/// Must be used on the GL thread, at most one Begin()/End() pair per frame.
+	/// </summary>
+	class GPUTimer
+	{
+	public:
+		void Create();
+		void Destroy();
+
+		void Begin();
+		void End();
+
+		double GetGPUTimeMs()const { return gpuTime.GetAverage(); }
+		double GetCPUTimeMs()const { return cpuTime.GetAverage(); }
+
+	private:
+		void Collect(uint32_t set);
+
+	private:
+		uint32_t queries[IAONNIS_GPU_TIMER_LATENCY][2] = {};
+		bool pending[IAONNIS_GPU_TIMER_LATENCY] = {};
+		uint32_t current = 0;
+		bool created = false;
+
+		std::chrono::steady_clock::time_point cpuStart;
+
+		TimingWindow gpuTime;
+		TimingWindow cpuTime;
+	};
+
+	/// @brief Times the enclosing scope with timer.
+	class ScopedGPUTimer
+	{
+	public:
+		explicit ScopedGPUTimer(GPUTimer& timer) :timer(timer) { timer.Begin(); }
+		~ScopedGPUTimer() { timer.End(); }
+
+		ScopedGPUTimer(const ScopedGPUTimer&) = delete;
+		ScopedGPUTimer& operator=(const ScopedGPUTimer&) = delete;
+
+	private:
+		GPUTimer& timer;
+	};
+}
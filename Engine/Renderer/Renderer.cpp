@@ -148,6 +148,10 @@ namespace Iaonnis {
 
 			LightMeta lightMeta{};
 
+			GPUTimer passTimers[(int)RenderPass::Count];
+
+			EventListenerHandle resizeListener;
+
 		}rendererData;
 
 		RendererStatistics RendererStats{};
@@ -193,12 +197,15 @@ namespace Iaonnis {
 			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
 			
 			glBufferStorage(GL_ARRAY_BUFFER, sizeof(Vertice) * rendererData.MAX_VERTEX, nullptr, flags);
+			MemoryTracker::TrackGPU(MemoryTag::Renderer, (int64_t)(sizeof(Vertice) * rendererData.MAX_VERTEX));
 			rendererData.vboPtr = glMapBufferRange(GL_ARRAY_BUFFER, 0, sizeof(Vertice) * rendererData.MAX_VERTEX, flags);
 
 			glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t) * rendererData.MAX_INDICES, nullptr, flags);
+			MemoryTracker::TrackGPU(MemoryTag::Renderer, (int64_t)(sizeof(uint32_t) * rendererData.MAX_INDICES));
 			rendererData.eboPtr = glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(uint32_t) * rendererData.MAX_INDICES, flags);
 
 			glBufferStorage(GL_DRAW_INDIRECT_BUFFER, sizeof(DrawElementsIndirectCommand) * rendererData.MAX_DRAW_COMMANDS, nullptr, flags);
+			MemoryTracker::TrackGPU(MemoryTag::Renderer, (int64_t)(sizeof(DrawElementsIndirectCommand) * rendererData.MAX_DRAW_COMMANDS));
 			rendererData.iboPtr = glMapBufferRange(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(DrawElementsIndirectCommand) * rendererData.MAX_DRAW_COMMANDS, flags);
 
 			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertice), 0);
@@ -301,6 +308,7 @@ namespace Iaonnis {
 
 			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
 			glBufferStorage(GL_SHADER_STORAGE_BUFFER, sizeof(MaterialUpload) * rendererData.MAX_MATERIALS, nullptr, flags);
+			MemoryTracker::TrackGPU(MemoryTag::Renderer, (int64_t)(sizeof(MaterialUpload) * rendererData.MAX_MATERIALS));
 			rendererData.materialBufferPtr = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, sizeof(MaterialUpload) * rendererData.MAX_MATERIALS, flags);
 
 			glGenBuffers(1, &rendererData.materialMapSSBO);
@@ -308,6 +316,7 @@ namespace Iaonnis {
 			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, (int)SSBO_SLOT::MaterialMap, rendererData.materialMapSSBO);
 
 			glBufferStorage(GL_SHADER_STORAGE_BUFFER, sizeof(int) * rendererData.MAX_SUBMESHES, nullptr, flags);
+			MemoryTracker::TrackGPU(MemoryTag::Renderer, (int64_t)(sizeof(int) * rendererData.MAX_SUBMESHES));
 			rendererData.materialMapBufferPtr = (int*)glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, sizeof(int) * rendererData.MAX_SUBMESHES, flags);
 		}
 
@@ -320,10 +329,14 @@ namespace Iaonnis {
 
 		void Iaonnis::Renderer3D::Initialize(uint32_t program)
 		{
-			SCOPE_TIMER(__FUNCTION__);
+			IAONNIS_PROFILE_FUNCTION();
+			IAONNIS_MEMORY_TAG(MemoryTag::Renderer);
 
 			CreateShaders();
 			CreateIndirectDrawBuffers();
+
+			for (auto& timer : rendererData.passTimers)
+				timer.Create();
 		
 			CreateMaterialSSBO();
 			CreateLightBuffers();
@@ -335,6 +348,7 @@ namespace Iaonnis {
 
 			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
 			glBufferStorage(GL_SHADER_STORAGE_BUFFER, sizeof(CommandData) * rendererData.MAX_DRAW_COMMANDS, nullptr, flags);
+			MemoryTracker::TrackGPU(MemoryTag::Renderer, (int64_t)(sizeof(CommandData) * rendererData.MAX_DRAW_COMMANDS));
 			rendererData.commandDataBufferPtr = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, sizeof(CommandData) * rendererData.MAX_DRAW_COMMANDS, flags);
 			
 			glGenBuffers(1, &rendererData.transformSSBO);
@@ -342,6 +356,7 @@ namespace Iaonnis {
 			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, (int)SSBO_SLOT::Transform, rendererData.transformSSBO);
 
 			glBufferStorage(GL_SHADER_STORAGE_BUFFER, sizeof(glm::mat4) * rendererData.MAX_DRAW_COMMANDS, nullptr, flags);
+			MemoryTracker::TrackGPU(MemoryTag::Renderer, (int64_t)(sizeof(glm::mat4) * rendererData.MAX_DRAW_COMMANDS));
 			rendererData.transformBufferPtr = (glm::mat4*)glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, sizeof(glm::mat4) * rendererData.MAX_DRAW_COMMANDS, flags);
 
 
@@ -507,12 +522,14 @@ namespace Iaonnis {
 			rendererData.currentIndexCount = 0;
 			//=====================================
 
-			EventBus::subscribe(EventType::RESIZE_EVENT, OnViewFrameResize);
+			rendererData.resizeListener = EventBus::subscribe<FrameResizeEvent, &OnViewFrameResize>();
 		}
 
 		void Shutdown()
 		{
-			SCOPE_TIMER(__FUNCTION__);
+			IAONNIS_PROFILE_FUNCTION();
+
+			EventBus::unsubscribe(rendererData.resizeListener);
 
 			glDeleteVertexArrays(1, &rendererData.vao);
 			glDeleteBuffers(1, &rendererData.vbo);
@@ -544,6 +561,9 @@ namespace Iaonnis {
 			IGPUResource::DeleteFramebuffer(rendererData.gBuffer);
 			IGPUResource::DeleteFramebuffer(rendererData.lightPassFBO);
 
+			for (auto& timer : rendererData.passTimers)
+				timer.Destroy();
+
 			IAONNIS_LOG_INFO("Renderer has shutdown");
 		}
 
@@ -590,11 +610,11 @@ namespace Iaonnis {
 			auto frustrum = camera->getFrustrum();
 			float cascadeLevels[4] = { frustrum.far / 50.0f, frustrum.far / 25.0f, frustrum.far / 10.0f, frustrum.far / 2.0f };
 
-			for (auto& entt : scene->getEntitiesWith<LightComponent>())
+			for (const Entity& entt : scene->getEntitiesWith<LightComponent>())
 			{
-				auto& lightComp = entt.GetComponent<LightComponent>();
-				auto& transform = entt.GetComponent<TransformComponent>();
-				if (entt.active == false || lightComp.type != LightType::Directional)
+				const auto& lightComp = entt.GetComponent<LightComponent>();
+				const auto& transform = entt.GetComponent<TransformComponent>();
+				if (!entt.IsActive() || lightComp.type != LightType::Directional)
 					continue;
 
 				auto mat = GetLightSpaceMatrices(scene->GetSceneCamera(), lightComp.position, cascadeLevels, 4);
@@ -614,10 +634,10 @@ namespace Iaonnis {
 
 			glBindBuffer(GL_UNIFORM_BUFFER, rendererData.lightSpaceMatrixUBO);
 			int l = 0;
-			for (auto& entt : scene->getEntitiesWith<LightComponent>())
+			for (const Entity& entt : scene->getEntitiesWith<LightComponent>())
 			{
-				auto& lightComp = entt.GetComponent<LightComponent>();
-				if (entt.active == false || lightComp.type != LightType::Directional)
+				const auto& lightComp = entt.GetComponent<LightComponent>();
+				if (!entt.IsActive() || lightComp.type != LightType::Directional)
 					continue;
 
 				CascadeMatrixSet* mat = &rendererData.lightSpaceMatrixArr[l];
@@ -643,6 +663,7 @@ namespace Iaonnis {
 
 		void WaitFence(GLsync& sync)
 		{
+			IAONNIS_PROFILE_FUNCTION();
 			if (sync)
 			{
 				while (true)
@@ -656,6 +677,8 @@ namespace Iaonnis {
 
 		void Iaonnis::Renderer3D::EnvironmentPass(Scene* scene)
 		{
+			ScopedGPUTimer timer(rendererData.passTimers[(int)RenderPass::Environment]);
+
 			// Make global...
 			IGPUResource::bindFramebuffer(rendererData.lightPassFBO);
 			glDepthMask(GL_FALSE);
@@ -688,68 +711,61 @@ namespace Iaonnis {
 			resetGeometryPtrs();
 
 			std::shared_ptr<ResourceCache> cache = scene->getCache();
-			std::vector<std::shared_ptr<Material>> materials = cache->getByType<Material>(ResourceType::Material);
-			std::vector<std::shared_ptr<Mesh>> meshes = cache->getByType<Mesh>(ResourceType::Mesh);
 			auto meshEntities = scene->getEntitiesWith<MeshFilterComponent>();
 
 			//-------------------------------------------------------------
-			for (auto& mesh : meshes)
+			for (const Entity& meshEntity : meshEntities)
 			{
-				auto meshID = mesh->GetID();
+				const auto& meshFilter = meshEntity.GetComponent<MeshFilterComponent>();
+				Mesh* mesh = cache->Get(meshFilter.mesh);
+				if (!mesh || !meshEntity.IsActive())
+					continue;
+
+				auto transform = meshEntity.GetTransformMatrix();
 				int subMeshCount = mesh->getSubMeshCount();
 
-				for (auto meshEntity : meshEntities)
+				for (int i = 0; i < subMeshCount; i++)
 				{
-					auto& meshFilter = meshEntity.GetComponent<MeshFilterComponent>();
-					auto transform = meshEntity.GetTransformMatrix();
+					SubMesh* subMesh = mesh->getSubMesh(i);
 
-					if (meshFilter.meshID != meshID || !meshEntity.active)
-						continue;
+					DrawData data;
+					data.indexCount = subMesh->indexCount;
+					data.indexPtr = mesh->getSubMeshIndexStart(i);
 
-					for (int i = 0; i < subMeshCount; i++)
-					{
-						SubMesh* subMesh = mesh->getSubMesh(i);
+					data.vertexCount = subMesh->vertexCount;
+					data.vertexPtr = mesh->getSubMeshVerticeStart(i);
 
-						DrawData data;
-						data.indexCount = subMesh->indexCount;
-						data.indexPtr = mesh->getSubMeshIndexStart(i);
+					SubmitDrawCommandData(data);
 
-						data.vertexCount = subMesh->vertexCount;
-						data.vertexPtr = mesh->getSubMeshVerticeStart(i);
-
-						SubmitDrawCommandData(data);
-
-						rendererData.materialMapBufferPtr[rendererData.subMeshOffset + i] = rendererData.materialMapCache[meshEntity.GetSubMeshMaterial(i)];
-					}
-
-					rendererData.transformBufferPtr[rendererData.commandPtr] = transform;
-					CloseDrawCommands();
+					rendererData.materialMapBufferPtr[rendererData.subMeshOffset + i] = rendererData.materialMapCache[meshFilter.materials[i]];
 				}
+
+				rendererData.transformBufferPtr[rendererData.commandPtr] = transform;
+				CloseDrawCommands();
 			}
 			rendererData.subMeshOffset = 0;
 		}
 
 		void Renderer3D::UploadMaterialArray(Scene* scene)
 		{
-			SCOPE_TIMER("MATERIAL_ARRAY_UPLOAD");
+			IAONNIS_PROFILE_SCOPE("MATERIAL_ARRAY_UPLOAD");
 			resetMaterialPtrs();
 
 			std::shared_ptr<ResourceCache> cache = scene->getCache();
-			std::vector<std::shared_ptr<Material>> materials = cache->getByType<Material>(ResourceType::Material);
-
 
 			int m = 0;
-			for (auto& material : materials)
+			cache->GetPool<Material>().ForEach([&](Material& materialResource, ResourceHandle<Material>)
 			{
+				Material* material = &materialResource;
 				if (!material->GetRefCount() || rendererData.materialMapCache.find(material->GetID()) != rendererData.materialMapCache.end())
-					continue;
+					return;
 				rendererData.materialMapCache[material->GetID()] = m++;
 
-				auto diffuseResource = cache->GetByUUID<ImageTexture>(material->getDiffuseID());
-				auto normalResource = cache->GetByUUID<ImageTexture>(material->getNormalID());
-				auto aoResource = cache->GetByUUID<ImageTexture>(material->getAoID());
-				auto roughnessResource = cache->GetByUUID<ImageTexture>(material->getRoughnessID());
-				auto metallicResource = cache->GetByUUID<ImageTexture>(material->getMetallicID());
+				ImageTexture* diffuseResource = cache->Get(material->GetMapHandle(TextureMapType::Albedo));
+				ImageTexture* normalResource = cache->Get(material->GetMapHandle(TextureMapType::Normal));
+				ImageTexture* aoResource = cache->Get(material->GetMapHandle(TextureMapType::AO));
+				ImageTexture* roughnessResource = cache->Get(material->GetMapHandle(TextureMapType::Roughness));
+				ImageTexture* metallicResource = cache->Get(material->GetMapHandle(TextureMapType::Metallic));
 
 				auto diffuseHandle = diffuseResource->getTextureHandle().handle;
 				auto normalHandle = normalResource->getTextureHandle().handle;
@@ -770,25 +786,23 @@ namespace Iaonnis {
 				};
 
 				rendererData.materialUploadPtr++;
-
-				//Stats
-				RendererStats.totalTextureBufferSize += diffuseResource->GetBytSize();
-				RendererStats.totalTextureBufferSize += normalResource->GetBytSize();
-				RendererStats.totalTextureBufferSize += aoResource->GetBytSize();
-				RendererStats.totalTextureBufferSize += roughnessResource->GetBytSize();
-				RendererStats.totalTextureBufferSize += metallicResource->GetBytSize();
-			}
+			});
 		}
 
-		void Iaonnis::Renderer3D::UploadLightData(Scene* scene)
+		void ExtractLights(Scene* scene)
 		{
-			SCOPE_TIMER("LIGHT_UPLOAD");
+			IAONNIS_PROFILE_FUNCTION();
+
+			if (!scene)
+				return;
 
-			for (auto& entt : scene->getEntitiesWith<LightComponent>())
+			resetLightPtrs();
+
+			for (const Entity& entt : scene->getEntitiesWith<LightComponent>())
 			{
-				auto& lightComp = entt.GetComponent<LightComponent>();
-				auto& transform = entt.GetComponent<TransformComponent>();
-				if (entt.active == false)
+				const auto& lightComp = entt.GetComponent<LightComponent>();
+				const auto& transform = entt.GetComponent<TransformComponent>();
+				if (!entt.IsActive())
 					continue;
 
 				switch (lightComp.type)
@@ -825,6 +839,12 @@ namespace Iaonnis {
 			}
 			
 			rendererData.lightMeta.viewPos = glm::vec4(scene->GetSceneCamera()->getFrustrum().position, 1.0f);
+		}
+
+		void Iaonnis::Renderer3D::UploadLightData()
+		{
+			IAONNIS_PROFILE_SCOPE("LIGHT_UPLOAD");
+			auto start = std::chrono::steady_clock::now();
 
 			{
 				glBindBuffer(GL_SHADER_STORAGE_BUFFER, rendererData.directionalLightSSBO);
@@ -839,11 +859,14 @@ namespace Iaonnis {
 				glBindBuffer(GL_UNIFORM_BUFFER, rendererData.lightMetaUBO);
 				glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(LightMeta), &rendererData.lightMeta);
 			}
+
+			RendererStats.lightUploadTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 		}
 
 		void Iaonnis::Renderer3D::LightPass(Scene* scene)
 		{
-			resetLightPtrs();
+			ScopedGPUTimer timer(rendererData.passTimers[(int)RenderPass::Light]);
+
 			IGPUResource::bindFramebuffer(rendererData.lightPassFBO);
 
 			glClearColor(0.40f, 0.40f, 0.40f, 1.0f);
@@ -886,7 +909,7 @@ namespace Iaonnis {
 			glUniform1i(location, 5);
 			
 
-			UploadLightData(scene);
+			UploadLightData();
 
 			glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 
@@ -928,7 +951,7 @@ namespace Iaonnis {
 
 		void CloseDrawCommands()
 		{
-			SCOPE_TIMER(__FUNCTION__);
+			IAONNIS_PROFILE_FUNCTION();
 
 			DrawElementsIndirectCommand cm;
 			cm.baseInstance = 0;
@@ -961,7 +984,7 @@ namespace Iaonnis {
 
 		void Iaonnis::Renderer3D::drawCommands(Scene* scene, uint32_t program)
 		{
-			SCOPE_TIMER(__FUNCTION__);
+			IAONNIS_PROFILE_FUNCTION();
 
 			glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -980,7 +1003,7 @@ namespace Iaonnis {
 
 		void Iaonnis::Renderer3D::resetGeometryPtrs()
 		{
-			SCOPE_TIMER(__FUNCTION__);
+			IAONNIS_PROFILE_FUNCTION();
 
 			rendererData.commandPtr = 0;
 			rendererData.currentVertexCount = 0;
@@ -994,7 +1017,6 @@ namespace Iaonnis {
 			RendererStats.nDrawCalls = 0;
 			RendererStats.nRenderedIndices = 0;
 			RendererStats.nRenderedVertices = 0;
-			RendererStats.totalTextureBufferSize = 0;
 		}
 
 		void resetLightPtrs()
@@ -1010,42 +1032,78 @@ namespace Iaonnis {
 			rendererData.materialMapCache.clear();
 		}
 
-		void RenderScene(Scene* scene, uint32_t program)
+		void ExecuteGPUCommands()
 		{
-			SCOPE_TIMER(__FUNCTION__);
+			GPUCommandQueueStats gpuCommands = GPUCommandQueue::ExecuteFrame();
+			RendererStats.gpuCommandsExecuted = gpuCommands.executedCommands;
+			RendererStats.gpuCommandsPending = gpuCommands.pendingCommands;
+			RendererStats.gpuCommandTime = gpuCommands.executionTime;
+		}
 
+		void BeginFrame(Scene* scene)
+		{
 			if (!scene)
-			{
 				return;
-			}
 
-			if (scene->IsEntityRegisteryDirty())
-			{
+			//The GPU may still be reading the mapped buffers the CPU stages are about to rewrite.
+			if (scene->IsEntityRegisteryDirty() || scene->IsMaterialsDirty())
 				WaitFence(rendererData.gSync);
+		}
 
-				UploadScene(scene);
-				scene->SetEntityRegisteryClean();
-			}
+		void BuildDrawCommands(Scene* scene)
+		{
+			if (!scene || !scene->IsEntityRegisteryDirty())
+				return;
 
-			if (scene->IsMaterialsDirty())
-			{
-				WaitFence(rendererData.gSync);
+			auto start = std::chrono::steady_clock::now();
+			UploadScene(scene);
+			RendererStats.sceneUploadTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 
-				UploadMaterialArray(scene);
-				scene->SetMaterialClean();
+			scene->SetEntityRegisteryClean();
+		}
+
+		void PrepareMaterials(Scene* scene)
+		{
+			if (!scene || !scene->IsMaterialsDirty())
+				return;
+
+			auto start = std::chrono::steady_clock::now();
+			UploadMaterialArray(scene);
+			RendererStats.materialUploadTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			scene->SetMaterialClean();
+		}
+
+		void RenderScene(Scene* scene, uint32_t program)
+		{
+			IAONNIS_PROFILE_FUNCTION();
+			IAONNIS_ASSERT_NO_ALLOCATIONS("Renderer3D::RenderScene");
+
+			if (!scene)
+			{
+				return;
 			}
 
 			/*CalculateCascadeMatrix(scene);
 			Renderer3D::LightPOVPass(scene);*/
 
-			IGPUResource::bindFramebuffer(rendererData.gBuffer);
-			drawCommands(scene,program);
+			{
+				ScopedGPUTimer timer(rendererData.passTimers[(int)RenderPass::Geometry]);
+				IGPUResource::bindFramebuffer(rendererData.gBuffer);
+				drawCommands(scene,program);
+			}
 
 			LockFence(rendererData.gSync);
 
 			LightPass(scene);
 			//EnvironmentPass(scene);
 
+			for (int i = 0; i < (int)RenderPass::Count; i++)
+			{
+				RendererStats.passTimings[i].cpuMs = rendererData.passTimers[i].GetCPUTimeMs();
+				RendererStats.passTimings[i].gpuMs = rendererData.passTimers[i].GetGPUTimeMs();
+			}
+
 		}
 
 		uint32_t GetRenderOutput()
@@ -1053,21 +1111,20 @@ namespace Iaonnis {
 			return rendererData.lightPassFBO.m_Handles[0].m_ID;
 		}
 
-		void OnViewFrameResize(Event& event)
+		void OnViewFrameResize(FrameResizeEvent& frameResizeEvent)
 		{
-			SCOPE_TIMER(__FUNCTION__);
+			IAONNIS_PROFILE_FUNCTION();
 
-			FrameResizeEvent* frameResizeEvent = (FrameResizeEvent*)&event;
-			rendererData.frameSize = glm::vec2(frameResizeEvent->frameSizeX, frameResizeEvent->frameSizeY);
+			rendererData.frameSize = glm::vec2(frameResizeEvent.frameSizeX, frameResizeEvent.frameSizeY);
 
-			glViewport(0, 0, frameResizeEvent->frameSizeX, frameResizeEvent->frameSizeY);
+			glViewport(0, 0, frameResizeEvent.frameSizeX, frameResizeEvent.frameSizeY);
 
 			FRAMEBUFFER_DESC fboDesc;
 			fboDesc.n_Desc = 3;
 			fboDesc.textureDesc = (TEXTURE_DESC*)malloc(sizeof(TEXTURE_DESC) * fboDesc.n_Desc);
 			fboDesc.textureDesc[0].dataType = TEXTURE_DATA::TEXTURE_COLOR;
-			fboDesc.textureDesc[0].height = frameResizeEvent->frameSizeY;
-			fboDesc.textureDesc[0].width = frameResizeEvent->frameSizeX;
+			fboDesc.textureDesc[0].height = frameResizeEvent.frameSizeY;
+			fboDesc.textureDesc[0].width = frameResizeEvent.frameSizeX;
 			fboDesc.textureDesc[0].nBitPerChannel = 32;
 			fboDesc.textureDesc[0].nChannels = 4;
 			fboDesc.textureDesc[0].ptr = nullptr;
@@ -1075,8 +1132,8 @@ namespace Iaonnis {
 			fboDesc.textureDesc[0].y = 0;
 
 			fboDesc.textureDesc[1].dataType = TEXTURE_DATA::TEXTURE_COLOR;
-			fboDesc.textureDesc[1].height = frameResizeEvent->frameSizeY;
-			fboDesc.textureDesc[1].width = frameResizeEvent->frameSizeX;
+			fboDesc.textureDesc[1].height = frameResizeEvent.frameSizeY;
+			fboDesc.textureDesc[1].width = frameResizeEvent.frameSizeX;
 			fboDesc.textureDesc[1].nBitPerChannel = 32;
 			fboDesc.textureDesc[1].nChannels = 4;
 			fboDesc.textureDesc[1].ptr = nullptr;
@@ -1084,8 +1141,8 @@ namespace Iaonnis {
 			fboDesc.textureDesc[1].y = 0;
 
 			fboDesc.textureDesc[2].dataType = TEXTURE_DATA::TEXTURE_DEPTH;
-			fboDesc.textureDesc[2].height = frameResizeEvent->frameSizeY;
-			fboDesc.textureDesc[2].width = frameResizeEvent->frameSizeX;
+			fboDesc.textureDesc[2].height = frameResizeEvent.frameSizeY;
+			fboDesc.textureDesc[2].width = frameResizeEvent.frameSizeX;
 			fboDesc.textureDesc[2].nBitPerChannel = 24;
 			fboDesc.textureDesc[2].nChannels = 1;
 			fboDesc.textureDesc[2].ptr = nullptr;
@@ -1099,8 +1156,8 @@ namespace Iaonnis {
 			gBufferDesc.n_Desc = 7;
 			gBufferDesc.textureDesc = (TEXTURE_DESC*)malloc(sizeof(TEXTURE_DESC) * gBufferDesc.n_Desc);
 			gBufferDesc.textureDesc[(int)gBufferHandles::Albedo].dataType = TEXTURE_DATA::TEXTURE_COLOR;
-			gBufferDesc.textureDesc[(int)gBufferHandles::Albedo].height = frameResizeEvent->frameSizeY;
-			gBufferDesc.textureDesc[(int)gBufferHandles::Albedo].width = frameResizeEvent->frameSizeX;
+			gBufferDesc.textureDesc[(int)gBufferHandles::Albedo].height = frameResizeEvent.frameSizeY;
+			gBufferDesc.textureDesc[(int)gBufferHandles::Albedo].width = frameResizeEvent.frameSizeX;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Albedo].nBitPerChannel = 32;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Albedo].nChannels = 4;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Albedo].ptr = nullptr;
@@ -1108,8 +1165,8 @@ namespace Iaonnis {
 			gBufferDesc.textureDesc[(int)gBufferHandles::Albedo].y = 0;
 
 			gBufferDesc.textureDesc[(int)gBufferHandles::Position].dataType = TEXTURE_DATA::TEXTURE_COLOR;
-			gBufferDesc.textureDesc[(int)gBufferHandles::Position].height = frameResizeEvent->frameSizeY;
-			gBufferDesc.textureDesc[(int)gBufferHandles::Position].width = frameResizeEvent->frameSizeX;
+			gBufferDesc.textureDesc[(int)gBufferHandles::Position].height = frameResizeEvent.frameSizeY;
+			gBufferDesc.textureDesc[(int)gBufferHandles::Position].width = frameResizeEvent.frameSizeX;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Position].nBitPerChannel = 32;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Position].nChannels = 4;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Position].ptr = nullptr;
@@ -1117,8 +1174,8 @@ namespace Iaonnis {
 			gBufferDesc.textureDesc[(int)gBufferHandles::Position].y = 0;
 
 			gBufferDesc.textureDesc[(int)gBufferHandles::Normal].dataType = TEXTURE_DATA::TEXTURE_COLOR;
-			gBufferDesc.textureDesc[(int)gBufferHandles::Normal].height = frameResizeEvent->frameSizeY;
-			gBufferDesc.textureDesc[(int)gBufferHandles::Normal].width = frameResizeEvent->frameSizeX;
+			gBufferDesc.textureDesc[(int)gBufferHandles::Normal].height = frameResizeEvent.frameSizeY;
+			gBufferDesc.textureDesc[(int)gBufferHandles::Normal].width = frameResizeEvent.frameSizeX;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Normal].nBitPerChannel = 32;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Normal].nChannels = 4;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Normal].ptr = nullptr;
@@ -1126,8 +1183,8 @@ namespace Iaonnis {
 			gBufferDesc.textureDesc[(int)gBufferHandles::Normal].y = 0;
 
 			gBufferDesc.textureDesc[(int)gBufferHandles::AO].dataType = TEXTURE_DATA::TEXTURE_COLOR;
-			gBufferDesc.textureDesc[(int)gBufferHandles::AO].height = frameResizeEvent->frameSizeY;
-			gBufferDesc.textureDesc[(int)gBufferHandles::AO].width = frameResizeEvent->frameSizeX;
+			gBufferDesc.textureDesc[(int)gBufferHandles::AO].height = frameResizeEvent.frameSizeY;
+			gBufferDesc.textureDesc[(int)gBufferHandles::AO].width = frameResizeEvent.frameSizeX;
 			gBufferDesc.textureDesc[(int)gBufferHandles::AO].nBitPerChannel = 32;
 			gBufferDesc.textureDesc[(int)gBufferHandles::AO].nChannels = 1;
 			gBufferDesc.textureDesc[(int)gBufferHandles::AO].ptr = nullptr;
@@ -1135,8 +1192,8 @@ namespace Iaonnis {
 			gBufferDesc.textureDesc[(int)gBufferHandles::AO].y = 0;
 
 			gBufferDesc.textureDesc[(int)gBufferHandles::Roughness].dataType = TEXTURE_DATA::TEXTURE_COLOR;
-			gBufferDesc.textureDesc[(int)gBufferHandles::Roughness].height = frameResizeEvent->frameSizeY;
-			gBufferDesc.textureDesc[(int)gBufferHandles::Roughness].width = frameResizeEvent->frameSizeX;
+			gBufferDesc.textureDesc[(int)gBufferHandles::Roughness].height = frameResizeEvent.frameSizeY;
+			gBufferDesc.textureDesc[(int)gBufferHandles::Roughness].width = frameResizeEvent.frameSizeX;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Roughness].nBitPerChannel = 32;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Roughness].nChannels = 1;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Roughness].ptr = nullptr;
@@ -1144,8 +1201,8 @@ namespace Iaonnis {
 			gBufferDesc.textureDesc[(int)gBufferHandles::Roughness].y = 0;
 
 			gBufferDesc.textureDesc[(int)gBufferHandles::Metallic].dataType = TEXTURE_DATA::TEXTURE_COLOR;
-			gBufferDesc.textureDesc[(int)gBufferHandles::Metallic].height = frameResizeEvent->frameSizeY;
-			gBufferDesc.textureDesc[(int)gBufferHandles::Metallic].width = frameResizeEvent->frameSizeX;
+			gBufferDesc.textureDesc[(int)gBufferHandles::Metallic].height = frameResizeEvent.frameSizeY;
+			gBufferDesc.textureDesc[(int)gBufferHandles::Metallic].width = frameResizeEvent.frameSizeX;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Metallic].nBitPerChannel = 32;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Metallic].nChannels = 1;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Metallic].ptr = nullptr;
@@ -1153,8 +1210,8 @@ namespace Iaonnis {
 			gBufferDesc.textureDesc[(int)gBufferHandles::Metallic].y = 0;
 
 			gBufferDesc.textureDesc[(int)gBufferHandles::Depth].dataType = TEXTURE_DATA::TEXTURE_DEPTH;
-			gBufferDesc.textureDesc[(int)gBufferHandles::Depth].height = frameResizeEvent->frameSizeY;
-			gBufferDesc.textureDesc[(int)gBufferHandles::Depth].width = frameResizeEvent->frameSizeX;
+			gBufferDesc.textureDesc[(int)gBufferHandles::Depth].height = frameResizeEvent.frameSizeY;
+			gBufferDesc.textureDesc[(int)gBufferHandles::Depth].width = frameResizeEvent.frameSizeX;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Depth].nBitPerChannel = 24;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Depth].nChannels = 1;
 			gBufferDesc.textureDesc[(int)gBufferHandles::Depth].ptr = nullptr;
@@ -1171,5 +1228,18 @@ namespace Iaonnis {
 		{
 			return RendererStats;
 		}
+
+		const char* GetRenderPassName(RenderPass pass)
+		{
+			switch (pass)
+			{
+				case RenderPass::Geometry: return "Geometry";
+				case RenderPass::Light: return "Light";
+				case RenderPass::Environment: return "Environment";
+				case RenderPass::Count: break;
+			}
+
+			return "Unknown";
+		}
 	}
 }
@@ -4,24 +4,46 @@
 #include "../Scene/Scene.h"
 #include "../Scene/Components.h"
 #include "../Scene/Entity.h"
+#include "../GPU/GPUCommandQueue.h"
+#include "../GPU/GPUTimer.h"
 
 namespace Iaonnis
 {
 	namespace Renderer3D
 	{
+		enum class RenderPass
+		{
+			Geometry, Light, Environment,
+
+			Count
+		};
+
+		/// @brief Averaged over the last IAONNIS_GPU_TIMER_WINDOW frames the pass ran in.
+		struct RenderPassTiming
+		{
+			double cpuMs = 0;
+			double gpuMs = 0;
+		};
+
 		struct RendererStatistics
 		{
 			size_t nDrawCalls = 0;
 			size_t nRenderedVertices = 0;
 			size_t nRenderedIndices = 0;
 
-			size_t totalTextureBufferSize = 0;
 
-			//Time Stamps
+			//Time Stamps (CPU, ms)
 			double sceneUploadTime = 0;
 			double materialUploadTime = 0;
 			double lightUploadTime = 0;
 
+			RenderPassTiming passTimings[(int)RenderPass::Count];
+
+			//GPU command queue
+			uint32_t gpuCommandsExecuted = 0;
+			size_t gpuCommandsPending = 0;
+			double gpuCommandTime = 0;
+
 		};
 
 		enum class SSBO_SLOT
@@ -67,7 +89,7 @@ namespace Iaonnis
 		void UploadScene(Scene* scene);
 		void UploadMaterialArray(Scene* scene);
 
-		void UploadLightData(Scene* scene);
+		void UploadLightData();
 		void LightPass(Scene* scene);
 
 		void SubmitDrawCommandData(DrawData data);
@@ -78,15 +100,27 @@ namespace Iaonnis
 		void resetLightPtrs();
 		void resetMaterialPtrs();
 
+		//Runs the queued GPU commands within the frame budget. Called on the GL thread before the frame graph executes:
+		//coroutines resumed on the GL thread may create entities, which must not happen while the stages read the scene.
+		void ExecuteGPUCommands();
+
+		//Frame stages. BeginFrame must run on the GL thread before the CPU stages touch the mapped buffers,
+		//RenderScene must run on the GL thread after all of them.
+		void BeginFrame(Scene* scene);
+		void BuildDrawCommands(Scene* scene);
+		void PrepareMaterials(Scene* scene);
+		void ExtractLights(Scene* scene);
+
 		void RenderScene(Scene* scene, uint32_t program);
 
 		//Temporary Output.
 		uint32_t GetRenderOutput();
 
 
-		void OnViewFrameResize(Event& event);
+		void OnViewFrameResize(FrameResizeEvent& event);
 
 		RendererStatistics GetRenderStats();
+		const char* GetRenderPassName(RenderPass pass);
 
 	}
 }
\ No newline at end of file
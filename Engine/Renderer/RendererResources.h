@@ -8,25 +8,20 @@ namespace Iaonnis
 	{
 		static GLuint CreateShaderProgram(const char* vertexPath, const char* fragmentPath, const char* geometryPath = nullptr)
 		{
-			// Helper to read file contents
-			auto readFile = [](const char* path) -> std::string {
-				std::ifstream file(path, std::ios::in | std::ios::binary);
-				if (!file) return "";
-				std::string contents;
-				file.seekg(0, std::ios::end);
-				contents.resize(static_cast<size_t>(file.tellg()));
-				file.seekg(0, std::ios::beg);
-				file.read(&contents[0], contents.size());
-				file.close();
-				return contents;
-				};
+			// Read every stage in one batch
+			std::vector<filespace::filepath> shaderPaths = { vertexPath, fragmentPath };
+			if (geometryPath)
+				shaderPaths.push_back(geometryPath);
+
+			std::vector<IOResult> sources = IOService::ReadFiles(shaderPaths);
+			auto toString = [](const IOResult& source) { return std::string(source.buffer.begin(), source.buffer.end()); };
 
-			std::string vertexCode = readFile(vertexPath);
-			std::string fragmentCode = readFile(fragmentPath);
+			std::string vertexCode = toString(sources[0]);
+			std::string fragmentCode = toString(sources[1]);
 			std::string geometryCode = "";
 			if (geometryPath)
 			{
-				geometryCode = readFile(geometryPath);
+				geometryCode = toString(sources[2]);
 			}
 
 
@@ -114,11 +109,12 @@ namespace Iaonnis
 
 
 
-		static std::vector<glm::vec4> GetFrustrumCornersWorldSpace(const glm::mat4& viewProj)
+		static std::array<glm::vec4, 8> GetFrustrumCornersWorldSpace(const glm::mat4& viewProj)
         {
             const auto inv = glm::inverse(viewProj);
 
-            std::vector<glm::vec4> frustumCorners;
+            std::array<glm::vec4, 8> frustumCorners;
+            int corner = 0;
             for (unsigned int x = 0; x < 2; ++x)
             {
                 for (unsigned int y = 0; y < 2; ++y)
@@ -126,7 +122,7 @@ namespace Iaonnis
                     for (unsigned int z = 0; z < 2; ++z)
                     {
                         const glm::vec4 pt = inv * glm::vec4(2.0f * x - 1.0f, 2.0f * y - 1.0f, 2.0f * z - 1.0f, 1.0f);
-                        frustumCorners.push_back(pt / pt.w);
+                        frustumCorners[corner++] = pt / pt.w;
                     }
                 }
             }
@@ -134,7 +130,7 @@ namespace Iaonnis
             return frustumCorners;
         }
 
-        static std::vector<glm::vec4> GetFrustrumCornersWorldSpace(const glm::mat4& proj, const glm::mat4& view)
+        static std::array<glm::vec4, 8> GetFrustrumCornersWorldSpace(const glm::mat4& proj, const glm::mat4& view)
         {
             return GetFrustrumCornersWorldSpace(proj * view);
         }
@@ -152,7 +148,7 @@ namespace Iaonnis
             {
                 center += glm::vec3(v);
             }
-            center /= corners.size();
+            center /= (float)corners.size();
 
             const auto lightView = glm::lookAt(center + lightDir, center, glm::vec3(0.0f, 1.0f, 0.0f));
 
@@ -195,10 +191,11 @@ namespace Iaonnis
             return lightProjection * lightView;
         }
 
-        static std::vector<glm::mat4> GetLightSpaceMatrices(std::shared_ptr<Camera> camera, glm::vec3 lightDir, float* cascadeLevels,int levelCount)
+        static FrameVector<glm::mat4> GetLightSpaceMatrices(std::shared_ptr<Camera> camera, glm::vec3 lightDir, float* cascadeLevels,int levelCount)
         {
             float level = 0.0f;
-            std::vector<glm::mat4> ret;
+            FrameVector<glm::mat4> ret;
+            ret.reserve(levelCount + 1);
             for (size_t i = 0; i < levelCount + 1; ++i)
             {
                 level = cascadeLevels[i];
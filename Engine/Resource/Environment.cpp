@@ -2,10 +2,18 @@
 
 namespace Iaonnis
 {
+	Environment::~Environment()
+	{
+		if (uploaded)
+			MemoryTracker::TrackGPU(MemoryTag::Texture, -(int64_t)GetGPUMemoryEstimate());
+	}
+
 	void Environment::load(filespace::filepath path)
 	{
-		std::ifstream file(path);
-		if (!file.is_open())
+		IAONNIS_MEMORY_TAG(MemoryTag::Texture);
+
+		std::string faceList;
+		if (!IOService::ReadTextFile(path, faceList))
 		{
 			IAONNIS_LOG_ERROR("Failed to read environment file.\n");
 			return;
@@ -15,8 +23,12 @@ namespace Iaonnis
 		std::vector<filespace::filepath> filePaths(6);
 		int a = 0;
 		std::string buffer;
-		while (std::getline(file, buffer))
+		std::istringstream file(faceList);
+		while (std::getline(file, buffer) && a < 6)
 		{
+			if (!buffer.empty() && buffer.back() == '\r')
+				buffer.pop_back();
+
 			filespace::filepath mapPath = parentPath / buffer;
 			if (!filespace::exists(mapPath))
 			{
@@ -28,14 +40,18 @@ namespace Iaonnis
 			a++;
 		}
 
-		file.close();
+		//All six faces are requested at once.
+		std::vector<IOResult> faces = IOService::ReadFiles(filePaths);
 
 		TEXTURE_DESC desc[6];
 		for (int i = 0; i < 6; i++)
 		{
-			if (stbi_is_16_bit(path.string().c_str()))
+			const stbi_uc* bytes = faces[i].buffer.data();
+			int byteCount = (int)faces[i].buffer.size();
+
+			if (stbi_is_16_bit_from_memory(bytes, byteCount))
 			{
-				unsigned short* data = stbi_load_16(filePaths[i].string().c_str(), &width, &hieght, &nChannel, 0);
+				unsigned short* data = stbi_load_16_from_memory(bytes, byteCount, &width, &hieght, &nChannel, 0);
 
 				desc[i].dataType = TEXTURE_DATA::TEXTURE_COLOR;
 				desc[i].height = hieght;
@@ -45,12 +61,13 @@ namespace Iaonnis
 				desc[i].nBitPerChannel = 16;
 				desc[i].nChannels = nChannel;
 				desc[i].ptr = data;
+				bitPerChannel = 16;
 
 				IAONNIS_LOG_WARN("Mem not being freed");
 			}
 			else
 			{
-				unsigned char* data = stbi_load(filePaths[i].string().c_str(), &width, &hieght, &nChannel, 0);
+				unsigned char* data = stbi_load_from_memory(bytes, byteCount, &width, &hieght, &nChannel, 0);
 
 				desc[i].dataType = TEXTURE_DATA::TEXTURE_COLOR;
 				desc[i].height = hieght;
@@ -60,12 +77,29 @@ namespace Iaonnis
 				desc[i].nBitPerChannel = 8;
 				desc[i].nChannels = nChannel;
 				desc[i].ptr = data;
+				bitPerChannel = 8;
 
 				IAONNIS_LOG_WARN("Mem not being freed");
 			}
 		}
 
-		handle = IGPUResource::createCubeMap(desc);
+		if (GPUCommandQueue::IsGLThread())
+		{
+			createCubeMap(desc);
+			return;
+		}
+
+		std::shared_ptr<Resource> self = shared_from_this();
+		std::array<TEXTURE_DESC, 6> faceDescs;
+		std::copy(std::begin(desc), std::end(desc), faceDescs.begin());
+		GPUCommandQueue::Enqueue([self, this, faceDescs]() mutable { createCubeMap(faceDescs.data()); });
+	}
+
+	void Environment::createCubeMap(TEXTURE_DESC* faces)
+	{
+		handle = IGPUResource::createCubeMap(faces);
+		uploaded = true;
+		MemoryTracker::TrackGPU(MemoryTag::Texture, (int64_t)GetGPUMemoryEstimate());
 	}
 
 	void Environment::save(filespace::filepath path)
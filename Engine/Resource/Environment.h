@@ -1,6 +1,7 @@
 #pragma once
 #include "Resource.h"
 #include "../GPU/GPUResource.h"
+#include "../GPU/GPUCommandQueue.h"
 
 namespace Iaonnis
 {
@@ -8,7 +9,7 @@ namespace Iaonnis
 	{
 	public:
 		Environment() = default;
-		~Environment() = default;
+		~Environment();
 
 		void load(filespace::filepath path) override;
 		void save(filespace::filepath path) override;
@@ -16,11 +17,19 @@ namespace Iaonnis
 
 		CubeMapHandle GetCubeMapHandle() { return handle; }
 
+		/// @brief Six faces, no mips.
+		virtual size_t GetGPUMemoryEstimate()const override { return 6 * (size_t)width * hieght * nChannel * bitPerChannel / 8; }
+
+	private:
+		void createCubeMap(TEXTURE_DESC* faces);
+
 	private:
-		int width;
-		int hieght;
-		int nChannel;
-		int bitPerChannel;
+		int width = 0;
+		int hieght = 0;
+		int nChannel = 0;
+		int bitPerChannel = 0;
+
+		bool uploaded = false;
 
 		CubeMapHandle handle;
 	};
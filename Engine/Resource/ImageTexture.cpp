@@ -19,20 +19,43 @@ namespace Iaonnis
 		desc.ptr = nullptr;
 
 		handle = IGPUResource::createGPUTexture(desc);
+		uploaded = true;
+		MemoryTracker::TrackGPU(MemoryTag::Texture, (int64_t)GetGPUMemoryEstimate());
 	}
 
 	ImageTexture::~ImageTexture()
 	{
-		IGPUResource::destroyTexture(handle);
+		if (uploaded)
+		{
+			MemoryTracker::TrackGPU(MemoryTag::Texture, -(int64_t)GetGPUMemoryEstimate());
+			IGPUResource::destroyTexture(handle);
+		}
 	}
 
 	void ImageTexture::load(filespace::filepath path)
 	{
+		IOResult file = IOService::ReadFile(path);
+		if (!file.Succeeded())
+		{
+			IAONNIS_LOG_ERROR("Failed to read image file. (Path = %s)", path.string().c_str());
+			return;
+		}
+
+		loadFromMemory(path, file.buffer);
+	}
+
+	void ImageTexture::loadFromMemory(filespace::filepath path, const std::vector<uint8_t>& fileData)
+	{
+		IAONNIS_PROFILE_FUNCTION();
+		IAONNIS_MEMORY_TAG(MemoryTag::Texture);
 		TEXTURE_DESC textureDesc;
 
-		if (stbi_is_16_bit(path.string().c_str()))
+		const stbi_uc* bytes = fileData.data();
+		int byteCount = (int)fileData.size();
+
+		if (stbi_is_16_bit_from_memory(bytes, byteCount))
 		{
-			unsigned short* data = stbi_load_16(path.string().c_str(), &width, &height, &nChannels, 0);
+			unsigned short* data = stbi_load_16_from_memory(bytes, byteCount, &width, &height, &nChannels, 0);
 			if (!data)
 			{
 				IAONNIS_LOG_ERROR("Failed to load image file. (Path = %s)", path.string());
@@ -43,7 +66,7 @@ namespace Iaonnis
 		}
 		else
 		{
-			unsigned char* data = stbi_load(path.string().c_str(), &width, &height, &nChannels, 0);
+			unsigned char* data = stbi_load_from_memory(bytes, byteCount, &width, &height, &nChannels, 0);
 			if (!data)
 			{
 				IAONNIS_LOG_ERROR("Failed to load image file. (Path = %s).", path.string());
@@ -62,9 +85,25 @@ namespace Iaonnis
 		textureDesc.x = 0;
 		textureDesc.y = 0;
 
+		if (GPUCommandQueue::IsGLThread())
+		{
+			createTexture(textureDesc);
+			return;
+		}
+
+		//Decoded off the GL thread, the upload waits for the renderer to drain the queue.
+		//The command keeps the texture alive until then.
+		std::shared_ptr<Resource> self = shared_from_this();
+		GPUCommandQueue::Enqueue([self, this, textureDesc]() { createTexture(textureDesc); });
+	}
+
+	void ImageTexture::createTexture(TEXTURE_DESC textureDesc)
+	{
+		IAONNIS_PROFILE_FUNCTION();
 		handle = IGPUResource::createGPUTexture(textureDesc);
 		desc = textureDesc;
-
+		uploaded = true;
+		MemoryTracker::TrackGPU(MemoryTag::Texture, (int64_t)GetGPUMemoryEstimate());
 	}
 	
 	void ImageTexture::save(filespace::filepath path)
@@ -1,6 +1,7 @@
 #pragma once
 #include "Resource.h"
 #include "../GPU/GPUResource.h"
+#include "../GPU/GPUCommandQueue.h"
 
 namespace Iaonnis
 {
@@ -14,6 +15,7 @@ namespace Iaonnis
 
 		void load(filespace::filepath path) override;
 		void save(filespace::filepath path) override;
+		void loadFromMemory(filespace::filepath path, const std::vector<uint8_t>& data) override;
 
 		int getWidth() const { return width; }
 		int getHeight() const { return height; }
@@ -22,8 +24,17 @@ namespace Iaonnis
 
 		size_t GetBytSize()const { return (width * height * nChannels * nBitPerChannel)/8; }
 
+		/// @brief Texel data plus a third for the mip chain.
+		virtual size_t GetGPUMemoryEstimate()const override { return uploaded ? GetBytSize() * 4 / 3 : 0; }
+
 		TextureHandle getTextureHandle() const { return handle; }
 
+		/// @brief False while the GPU texture is still waiting in the GPUCommandQueue.
+		bool IsUploaded() const { return uploaded; }
+
+	private:
+		void createTexture(TEXTURE_DESC textureDesc);
+
 	private:
 
 		int width;
@@ -31,8 +42,10 @@ namespace Iaonnis
 		int nChannels;
 		int nBitPerChannel;
 
-		TextureHandle handle;
+		TextureHandle handle{};
 		TEXTURE_DESC  desc;
+
+		std::atomic<bool> uploaded{ false };
 	};
 
 }
\ No newline at end of file
@@ -19,6 +19,7 @@ namespace Iaonnis {
 		aoMap = other.aoMap;
 		roughnessMap = other.roughnessMap;
 		metallicMap = other.metallicMap;
+		mapHandles = other.mapHandles;
 		refCount = 0;
 	}
 
@@ -36,7 +37,7 @@ namespace Iaonnis {
 		IAONNIS_LOG_WARN("Not Saving Material Resource");
 	}
 
-	void Iaonnis::Material::SetMap(TextureMapType type, UUID map)
+	void Iaonnis::Material::SetMap(TextureMapType type, const std::shared_ptr<ImageTexture>& map)
 	{
 		switch (type)
 		{
@@ -48,16 +49,18 @@ namespace Iaonnis {
 		}
 	}
 
-	UUID& Material::GetMap(TextureMapType type)
+	UUID Material::GetMap(TextureMapType type)const
 	{
 		switch (type)
 		{
-		case TextureMapType::Albedo: return GetDiffuseID();
-		case TextureMapType::Normal: return GetNormalID();
-		case TextureMapType::AO:     return GetAoID();
-		case TextureMapType::Roughness:return GetRoughnessID();
+		case TextureMapType::Albedo: return getDiffuseID();
+		case TextureMapType::Normal: return getNormalID();
+		case TextureMapType::AO:     return getAoID();
+		case TextureMapType::Roughness:return getRoughnessID();
 		case TextureMapType::Metallic: return getMetallicID();
 		}
+
+		return UUIDFactory::getInvalidUUID();
 	}
 
 	std::string Material::GetMapTypeString(TextureMapType type)
@@ -78,13 +81,21 @@ namespace Iaonnis {
 	{
 		albedo.color = color;
 	}
-	void Material::setDiffuseMap(UUID diffuseID)
+	void Material::setDiffuseMap(const std::shared_ptr<ImageTexture>& map)
 	{
-		albedo.diffuseMap = diffuseID;
+		if (!map)
+			return;
+
+		albedo.diffuseMap = map->GetID();
+		mapHandles[(int)TextureMapType::Albedo] = map->GetHandle<ImageTexture>();
 	}
-	void Material::setNormalMap(UUID normalID)
+	void Material::setNormalMap(const std::shared_ptr<ImageTexture>& map)
 	{
-		normal.normalMap = normalID;
+		if (!map)
+			return;
+
+		normal.normalMap = map->GetID();
+		mapHandles[(int)TextureMapType::Normal] = map->GetHandle<ImageTexture>();
 	}
 	void Material::setNormalStrenght(float strength)
 	{
@@ -94,17 +105,29 @@ namespace Iaonnis {
 	{
 		normal.flipY *= -1;
 	}
-	void Material::setAoMap(UUID map)
+	void Material::setAoMap(const std::shared_ptr<ImageTexture>& map)
 	{
-		aoMap = map;
+		if (!map)
+			return;
+
+		aoMap = map->GetID();
+		mapHandles[(int)TextureMapType::AO] = map->GetHandle<ImageTexture>();
 	}
-	void Iaonnis::Material::setRoughnessMap(UUID rMap)
+	void Iaonnis::Material::setRoughnessMap(const std::shared_ptr<ImageTexture>& map)
 	{
-		roughnessMap = rMap;
+		if (!map)
+			return;
+
+		roughnessMap = map->GetID();
+		mapHandles[(int)TextureMapType::Roughness] = map->GetHandle<ImageTexture>();
 	}
-	void Material::setMetallicMap(UUID map)
+	void Material::setMetallicMap(const std::shared_ptr<ImageTexture>& map)
 	{
-		metallicMap = map;
+		if (!map)
+			return;
+
+		metallicMap = map->GetID();
+		mapHandles[(int)TextureMapType::Metallic] = map->GetHandle<ImageTexture>();
 	}
 	void Material::setUVScale(glm::vec2 scale)
 	{
@@ -138,10 +161,6 @@ namespace Iaonnis {
 	{
 		return metallicMap;
 	}
-	UUID& Material::getMetallicID()
-	{
-		return metallicMap;
-	}
 	float Material::getNormalStrength() const
 	{
 		return normal.normalStrength;
@@ -48,22 +48,19 @@ namespace Iaonnis
 		void load(filespace::filepath path) override;
 		void save(filespace::filepath path) override;
 
-		//Blind Functions
-		void SetMap(TextureMapType type, UUID map);
-		UUID& GetMap(TextureMapType type);
+		/// @brief The only way to bind a map, keeps the serialized UUID and the pool handle in step. Ignores a null map.
+		void SetMap(TextureMapType type, const std::shared_ptr<ImageTexture>& map);
+		UUID GetMap(TextureMapType type)const;
 		static std::string GetMapTypeString(TextureMapType type);
 
+		/// @brief Pool handle of the texture bound to type, what the renderer resolves. The UUID is kept for serialization.
+		ResourceHandle<ImageTexture> GetMapHandle(TextureMapType type)const { return mapHandles[(int)type]; }
+
 		void setColor(glm::vec4 color);
-		void setDiffuseMap(UUID diffuseID);
 
-		void setNormalMap(UUID normalID);
 		void setNormalStrenght(float strength);
 		void flipNormalY();
 
-		void setAoMap(UUID aoMap);
-		void setRoughnessMap(UUID roughnessMap);
-		void setMetallicMap(UUID metallicMap);
-
 		void setUVScale(glm::vec2 scale);
 
 		glm::vec2 getUVScale()const;
@@ -79,14 +76,15 @@ namespace Iaonnis
 		const UUID getRoughnessID()const;
 		const UUID getMetallicID()const;
 
-		UUID& GetDiffuseID() { return albedo.diffuseMap; }
-		UUID& GetNormalID() { return normal.normalMap; }
-		UUID& GetAoID() { return aoMap; }
-		UUID& GetRoughnessID() { return roughnessMap; }
-		UUID& getMetallicID();
-
 		float getNormalStrength()const;
 
+	private:
+		void setDiffuseMap(const std::shared_ptr<ImageTexture>& diffuseMap);
+		void setNormalMap(const std::shared_ptr<ImageTexture>& normalMap);
+		void setAoMap(const std::shared_ptr<ImageTexture>& aoMap);
+		void setRoughnessMap(const std::shared_ptr<ImageTexture>& roughnessMap);
+		void setMetallicMap(const std::shared_ptr<ImageTexture>& metallicMap);
+
 	private:
 		AlbedoProperty albedo;
 		NormalProperty normal;
@@ -95,6 +93,8 @@ namespace Iaonnis
 		UUID roughnessMap;
 		UUID metallicMap;
 
+		std::array<ResourceHandle<ImageTexture>, 5> mapHandles;
+
 		glm::vec2 uvScale;
 	};
 }
\ No newline at end of file
@@ -36,10 +36,17 @@ namespace Iaonnis
         :vertices(other.vertices), indices(other.indices), subMeshes(other.subMeshes)
     {
         refCount = 0;
+        UpdateGPUTracking();
+    }
+
+    Mesh::~Mesh()
+    {
+        MemoryTracker::TrackGPU(MemoryTag::Mesh, -(int64_t)trackedGPUBytes);
     }
 
 	void Mesh::load(filespace::filepath path)
 	{
+        IAONNIS_MEMORY_TAG(MemoryTag::Mesh);
         const std::string extension = path.extension().string();
 
         if (extension == ".obj")
@@ -50,8 +57,28 @@ namespace Iaonnis
         {
             loadMeshFile(path);
         }
+
+        UpdateGPUTracking();
 	}
 
+    void Mesh::loadFromMemory(filespace::filepath path, const std::vector<uint8_t>& data)
+    {
+        IAONNIS_PROFILE_FUNCTION();
+        IAONNIS_MEMORY_TAG(MemoryTag::Mesh);
+        const std::string extension = path.extension().string();
+
+        if (extension == ".obj")
+        {
+            parseObjFile(path, data);
+        }
+        else if (extension == ".mesh")
+        {
+            parseMeshFile(path, data);
+        }
+
+        UpdateGPUTracking();
+    }
+
 	void Mesh::save(filespace::filepath path)
 	{
         std::string extension = path.extension().string();
@@ -106,6 +133,7 @@ namespace Iaonnis
 
     void Mesh::generateCube(Mesh* mesh)
     {
+        IAONNIS_MEMORY_TAG(MemoryTag::Mesh);
         SubMesh subMesh;
         subMesh.indexCount = 36;
         subMesh.indexOffset = 0;
@@ -179,10 +207,12 @@ namespace Iaonnis
 
         mesh->generateTangentBitangent();
         mesh->generateNormals();
+        mesh->UpdateGPUTracking();
     }
 
     void Mesh::generatePlane(Mesh* mesh)
     {
+        IAONNIS_MEMORY_TAG(MemoryTag::Mesh);
 
         SubMesh subMesh;
         subMesh.indexCount = 6;
@@ -205,10 +235,12 @@ namespace Iaonnis
 
         mesh->generateTangentBitangent();
         mesh->generateNormals();
+        mesh->UpdateGPUTracking();
     }
 
     void Mesh::generateCylinder(Mesh* mesh)
     {
+        IAONNIS_MEMORY_TAG(MemoryTag::Mesh);
        /* SubMesh subMesh;
         subMesh.index = 0;
         subMesh.indexCount;
@@ -255,27 +287,53 @@ namespace Iaonnis
 
 	void Mesh::loadObjFile(filespace::filepath path)
 	{
-        tinyobj::ObjReaderConfig config;
-        tinyobj::ObjReader reader;
-        config.triangulate = true;
+        IOResult file = IOService::ReadFile(path);
+        if (!file.Succeeded())
+        {
+            IAONNIS_LOG_ERROR("Failed to read Obj File");
+            return;
+        }
+
+        parseObjFile(path, file.buffer);
+    }
 
-        if (!reader.ParseFromFile(path.string()))
+    void Mesh::parseObjFile(filespace::filepath path, const std::vector<uint8_t>& data)
+    {
+        //Reads the obj text in place instead of copying it into a string stream.
+        struct MemoryBuffer : std::streambuf
         {
-            if (!reader.Error().empty())
+            MemoryBuffer(const std::vector<uint8_t>& data)
             {
-                IAONNIS_LOG_ERROR("[TinyObj]: %s", reader.Error().c_str());
+                char* begin = (char*)data.data();
+                setg(begin, begin, begin + data.size());
+            }
+        };
+
+        MemoryBuffer buffer(data);
+        std::istream stream(&buffer);
+
+        //The .mtl files named by the obj are looked up next to it, as ObjReader::ParseFromFile does.
+        tinyobj::MaterialFileReader materialReader(path.parent_path().string());
+
+        tinyobj::attrib_t attrib;
+        std::vector<tinyobj::shape_t> shapes;
+        std::vector<tinyobj::material_t> materials;
+        std::string warning;
+        std::string error;
+
+        if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warning, &error, &stream, &materialReader, true))
+        {
+            if (!error.empty())
+            {
+                IAONNIS_LOG_ERROR("[TinyObj]: %s", error.c_str());
             }
             return;
         }
-        if (!reader.Warning().empty())
+        if (!warning.empty())
         {
-            IAONNIS_LOG_WARN("[TinyObj]: %s", reader.Warning().c_str());
+            IAONNIS_LOG_WARN("[TinyObj]: %s", warning.c_str());
         }
 
-        const tinyobj::attrib_t& attrib = reader.GetAttrib();
-        const std::vector<tinyobj::shape_t>& shapes = reader.GetShapes();
-        const std::vector<tinyobj::material_t>& materials = reader.GetMaterials();
-
         subMeshes.resize(shapes.size());
 
         //Load Geometry Data
@@ -283,7 +341,7 @@ namespace Iaonnis
         {
             const auto& shape = shapes[s];
 
-            subMeshes[s].name = shape.name;
+            subMeshes[s].name = StringId(shape.name);
             subMeshes[s].vertexOffset = vertices.size();
             subMeshes[s].indexOffset = indices.size();
             subMeshes[s].index = s;
@@ -379,27 +437,66 @@ namespace Iaonnis
 
     void Mesh::loadMeshFile(filespace::filepath path)
     {
-        std::ifstream file(path.string(), std::ios::binary);
-        if (!file.is_open())
+        IOResult file = IOService::ReadFile(path);
+        if (!file.Succeeded())
         {
             IAONNIS_LOG_ERROR("Failed to read Mesh File");
             return;
         }
 
+        parseMeshFile(path, file.buffer);
+    }
+
+    void Mesh::parseMeshFile(filespace::filepath path, const std::vector<uint8_t>& data)
+    {
+        size_t cursor = 0;
+        auto read = [&](void* destination, size_t size) -> bool
+            {
+                if (cursor + size > data.size())
+                    return false;
+
+                memcpy(destination, data.data() + cursor, size);
+                cursor += size;
+                return true;
+            };
+
         MeshFileHeader header;
-        file.read(reinterpret_cast<char*>(&header), sizeof(MeshFileHeader));
+        if (!read(&header, sizeof(MeshFileHeader)))
+        {
+            IAONNIS_LOG_ERROR("Invalid Mesh File. (Path = %s)", path.string().c_str());
+            return;
+        }
+
         if (strcmp(header.magic, "IAONNIS"))
         {
             IAONNIS_LOG_ERROR("Invalid Mesh File. (Path = %s)", path.string());
             /*return*/;
         }
+
+        if (header.meshCount > data.size() || header.vertexCount > data.size() || header.indexCount > data.size() || header.stringTableLength > data.size())
+        {
+            IAONNIS_LOG_ERROR("Truncated Mesh File. (Path = %s)", path.string().c_str());
+            return;
+        }
+
         std::vector<SubMeshHeader> subMeshHeaders(header.meshCount);
-        std::vector<std::string> stringMap;
+        std::vector<char> stringMap(header.stringTableLength);
 
-        file.read(reinterpret_cast<char*>(subMeshHeaders.data()), sizeof(SubMeshHeader) * header.meshCount);
-        file.read(reinterpret_cast<char*>(vertices.data()), sizeof(Vertice) * header.vertexCount);
-        file.read(reinterpret_cast<char*>(indices.data()), sizeof(uint32_t) * header.indexCount);
-        file.read(reinterpret_cast<char*>(stringMap.data()), header.stringTableLength);
+        vertices.resize(header.vertexCount);
+        indices.resize(header.indexCount);
+
+        bool complete = read(subMeshHeaders.data(), sizeof(SubMeshHeader) * header.meshCount)
+            && read(vertices.data(), sizeof(Vertice) * header.vertexCount)
+            && read(indices.data(), sizeof(uint32_t) * header.indexCount)
+            && read(stringMap.data(), header.stringTableLength);
+
+        if (!complete)
+        {
+            IAONNIS_LOG_ERROR("Truncated Mesh File. (Path = %s)", path.string().c_str());
+            vertices.clear();
+            indices.clear();
+            return;
+        }
 
         subMeshes.resize(header.meshCount);
 
@@ -407,15 +504,16 @@ namespace Iaonnis
         for (auto& subMesh : subMeshHeaders)
         {
             std::string name = "";
-            name.resize(subMesh.nameLength, 'c');
-            _memccpy(name.data(), stringMap.data() + subMesh.nameOffset, 0, subMesh.nameLength);
-            subMeshes[i].name = name;
+            if (subMesh.nameOffset + subMesh.nameLength <= stringMap.size())
+                name.assign(stringMap.data() + subMesh.nameOffset, subMesh.nameLength);
+            subMeshes[i].name = StringId(name);
 
             subMeshes[i].vertexCount  = subMesh.vertexCount;
             subMeshes[i].vertexOffset = subMesh.vertexOffset;
 
             subMeshes[i].indexCount  = subMesh.indexCount;
             subMeshes[i].indexOffset = subMesh.indexOffset;
+            i++;
         }
     }
 
@@ -442,8 +540,8 @@ namespace Iaonnis
         std::vector<std::string> stringTable(header.meshCount + 1);
 
         size_t namePtr = 0;
-        stringTable[0] = name;
-        namePtr += name.size();
+        stringTable[0] = name.str();
+        namePtr += name.str().size();
 
         int i = 0;
         for (auto& subMesh : subMeshes)
@@ -454,11 +552,11 @@ namespace Iaonnis
             subMeshHeaders[i].vertexCount  = subMesh.vertexCount;
             subMeshHeaders[i].vertexOffset = subMesh.vertexOffset;
 
-            subMeshHeaders[i].nameLength = subMesh.name.size();
+            subMeshHeaders[i].nameLength = subMesh.name.str().size();
             subMeshHeaders[i].nameOffset = namePtr;
 
-            stringTable[i + 1] = subMesh.name;
-            namePtr += subMesh.name.size();
+            stringTable[i + 1] = subMesh.name.str();
+            namePtr += subMesh.name.str().size();
             i++;
         }
 
@@ -530,6 +628,13 @@ namespace Iaonnis
         }
     }
 
+    void Mesh::UpdateGPUTracking()
+    {
+        size_t bytes = GetGPUMemoryEstimate();
+        MemoryTracker::TrackGPU(MemoryTag::Mesh, (int64_t)bytes - (int64_t)trackedGPUBytes);
+        trackedGPUBytes = bytes;
+    }
+
     void Mesh::generateNormals()
     {
         IAONNIS_LOG_WARN("No Normals have been generated yet");
@@ -36,7 +36,7 @@ namespace Iaonnis
 		uint32_t indexCount;
 
 		int index;
-		std::string name;
+		StringId name;
 	};
 
 	class Mesh : public Resource
@@ -44,10 +44,14 @@ namespace Iaonnis
 		public:
 			Mesh();
 			Mesh(const Mesh& other);
-			~Mesh() = default;
+			~Mesh();
 
 			virtual void load(filespace::filepath path)override;
 			virtual void save(filespace::filepath path)override;
+			virtual void loadFromMemory(filespace::filepath path, const std::vector<uint8_t>& data)override;
+
+			/// @brief Space the mesh takes in the renderer's shared vertex and index buffers.
+			virtual size_t GetGPUMemoryEstimate()const override { return vertices.size() * sizeof(Vertice) + indices.size() * sizeof(uint32_t); }
 
 			SubMesh* getSubMesh(int index);
 			int getSubMeshCount()const { return subMeshes.size(); }
@@ -67,18 +71,25 @@ namespace Iaonnis
 		
 		private:
 			void loadObjFile(filespace::filepath path);
+			void parseObjFile(filespace::filepath path, const std::vector<uint8_t>& data);
 			void loadMeshFile(filespace::filepath path);
+			void parseMeshFile(filespace::filepath path, const std::vector<uint8_t>& data);
 
 			void saveMeshFile(filespace::filepath path);
 
 			void generateTangentBitangent();
 			void generateNormals();
+
+			/// @brief Brings the Mesh tag's GPU bytes in line with GetGPUMemoryEstimate() after the geometry changed.
+			void UpdateGPUTracking();
 		private:
 			std::vector<Vertice> vertices;
 			std::vector<uint32_t> indices;
 			std::vector<SubMesh> subMeshes;
 
 			std::vector<SubMeshTexturePaths> texturePaths;
+
+			size_t trackedGPUBytes = 0;
 	};
 
 }
\ No newline at end of file
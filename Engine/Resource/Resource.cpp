@@ -9,12 +9,36 @@ namespace Iaonnis
 
 	const std::string& Resource::getName()const
 	{
-		return name;
+		return name.str();
 	}
 
-	const filespace::filepath& Resource::getPath() const
+	filespace::filepath Resource::getPath() const
 	{
-		return path;
+		return filespace::filepath(path.str());
+	}
+
+	static std::string CanonicalPath(const filespace::filepath& path)
+	{
+		std::error_code error;
+		filespace::filepath absolutePath = std::filesystem::absolute(path, error);
+		if (error)
+			absolutePath = path;
+
+		std::string key = absolutePath.lexically_normal().generic_string();
+#ifdef _WIN32
+		std::transform(key.begin(), key.end(), key.begin(), [](char c) { return (char)std::tolower((unsigned char)c); });
+#endif
+		return key;
+	}
+
+	StringId Resource::InternPath(const filespace::filepath& path)
+	{
+		return StringId(CanonicalPath(path));
+	}
+
+	StringId Resource::FindPath(const filespace::filepath& path)
+	{
+		return StringId::Find(CanonicalPath(path));
 	}
 
 	ResourceType Resource::getType() const
@@ -35,8 +59,8 @@ namespace Iaonnis
 	}
 
 	void Resource::unuse(int count) {
-		refCount -= count; 
-		IAONNIS_ASSERT(refCount >= 0, "Reference Count cannot be negative");
+		int previous = refCount.fetch_sub(count, std::memory_order_relaxed);
+		IAONNIS_ASSERT(previous - count >= 0, "Reference Count cannot be negative");
 	}
 
 }
\ No newline at end of file
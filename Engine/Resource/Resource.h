@@ -1,6 +1,7 @@
 #pragma once
 #include "../Core/Core.h"
 #include "../Core/pch.h"
+#include "ResourceHandle.h"
 
 namespace Iaonnis
 {
@@ -14,7 +15,7 @@ namespace Iaonnis
 	};
 
 	class ResourceCache;
-	class Resource
+	class Resource : public std::enable_shared_from_this<Resource>
 	{
 	public: 
 		Resource() = default;
@@ -23,13 +24,35 @@ namespace Iaonnis
 		virtual void load(filespace::filepath path) = 0;
 		virtual void save(filespace::filepath path) = 0;
 
+		/// @brief Builds the resource from file contents that were already read, e.g. by an IOService batch.
+		/// The default ignores the contents and falls back to load(path), reading the file a second time;
+		/// resources that can decode from memory override it, as Mesh does for .obj and .mesh files.
+		virtual void loadFromMemory(filespace::filepath path, [[maybe_unused]] const std::vector<uint8_t>& data) { load(path); }
+
 		UUID& GetID(){ return id; }
 		const UUID& GetID()const;
 		const std::string& getName()const;
-		const filespace::filepath& getPath()const;
+		filespace::filepath getPath()const;
+
+		/// @brief Interned name and canonical path, compare these instead of the strings.
+		StringId GetNameId()const { return name; }
+		StringId GetPathId()const { return pathKey; }
+
+		/// @brief Paths are interned in canonical form, absolute and normalized with generic separators and
+		/// lower case on Windows, so that relative and absolute spellings of one file share an id.
+		/// The cache indexes resources by this id. getPath() keeps the spelling the resource was given.
+		static StringId InternPath(const filespace::filepath& path);
+		static StringId FindPath(const filespace::filepath& path);
 		ResourceType getType()const;
 
-		int GetRefCount()const { return refCount; }
+		/// @brief Handle into the owning cache's pool for T. Null until the resource is cached.
+		template<class T>
+		ResourceHandle<T> GetHandle()const { return ResourceHandle<T>(poolHandle); }
+
+		/// @brief Rough size of the GPU objects backing the resource, 0 for CPU-only resources.
+		virtual size_t GetGPUMemoryEstimate()const { return 0; }
+
+		int GetRefCount()const { return refCount.load(std::memory_order_relaxed); }
 
 		static std::string getTypeString(ResourceType type);
 		
@@ -37,18 +60,21 @@ namespace Iaonnis
 		friend 	class ResourceCache;
 
 		void setUUID(UUID i) { id = i; }
-		void setName(const std::string& nme) { name = nme; }
-		void setPath(filespace::filepath p) { path = p; }
+		void setName(const std::string& nme) { name = StringId(nme); }
+		void setPath(filespace::filepath p) { path = StringId(p.lexically_normal().generic_string()); pathKey = InternPath(p); }
+		void setPoolHandle(uint32_t h) { poolHandle = h; }
 
-		void use(int count = 1) { refCount += count; }
+		void use(int count = 1) { refCount.fetch_add(count, std::memory_order_relaxed); }
 		void unuse(int count = 1);
 
 	protected:
 		UUID id;
-		std::string name;
-		filespace::filepath path;
+		StringId name;
+		StringId path;
+		StringId pathKey;
 		ResourceType type;
+		uint32_t poolHandle = 0;
 
-		int refCount = 0;
+		std::atomic<int> refCount{ 0 };
 	};
 }
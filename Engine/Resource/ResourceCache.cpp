@@ -56,11 +56,19 @@ namespace Iaonnis
 
 	void ResourceCache::LoadDefaultIcons()
 	{
-		defaultIcons[IconType::Plus] = load<ImageTexture>("Assets/Icons/plus.png");
-		defaultIcons[IconType::New] = load<ImageTexture>("Assets/Icons/addNew.png");
-		defaultIcons[IconType::Duplicate] = load<ImageTexture>("Assets/Icons/duplicate.png");
-		defaultIcons[IconType::Remove] = load<ImageTexture>("Assets/Icons/x.png");
-		defaultIcons[IconType::Open] = load<ImageTexture>("Assets/Icons/open.png");
+		auto icons = loadBatch<ImageTexture>({
+			"Assets/Icons/plus.png",
+			"Assets/Icons/addNew.png",
+			"Assets/Icons/duplicate.png",
+			"Assets/Icons/x.png",
+			"Assets/Icons/open.png"
+		});
+
+		defaultIcons[IconType::Plus] = icons[0];
+		defaultIcons[IconType::New] = icons[1];
+		defaultIcons[IconType::Duplicate] = icons[2];
+		defaultIcons[IconType::Remove] = icons[3];
+		defaultIcons[IconType::Open] = icons[4];
 
 		return IAONNIS_LOG_DEBUG("Default Icons Loaded.");
 	}
@@ -69,26 +77,32 @@ namespace Iaonnis
 	{
 		stbi_set_flip_vertically_on_load(true);
 
-		memset(&meta, 0, sizeof(ResourceCacheMeta));
-
 		auto cube = create<Mesh>("Cube.mesh");
 		auto plane = create<Mesh>("Plane.mesh");
 
 		Mesh::generateCube(cube.get());
 		Mesh::generatePlane(plane.get());
 
-		flatDiffuse = load<ImageTexture>("Assets/Textures/default_diffuse.png");
-		flatNormal  = load<ImageTexture>("Assets/Textures/default_normal.png");
-		flatAO      = load<ImageTexture>("Assets/Textures/default_ambient_occlusion.png");
-		flatRoughness = load<ImageTexture>("Assets/Textures/default_roughness.png");
-		flatMetallic = load<ImageTexture>("Assets/Textures/default_metallic.png");
+		auto defaultTextures = loadBatch<ImageTexture>({
+			"Assets/Textures/default_diffuse.png",
+			"Assets/Textures/default_normal.png",
+			"Assets/Textures/default_ambient_occlusion.png",
+			"Assets/Textures/default_roughness.png",
+			"Assets/Textures/default_metallic.png"
+		});
+
+		flatDiffuse = defaultTextures[0];
+		flatNormal  = defaultTextures[1];
+		flatAO      = defaultTextures[2];
+		flatRoughness = defaultTextures[3];
+		flatMetallic = defaultTextures[4];
 
 		defaultMaterial = create<Material>("Material.yaml");
-		defaultMaterial->setDiffuseMap(flatDiffuse->GetID());
-		defaultMaterial->setNormalMap(flatNormal->GetID());
-		defaultMaterial->setAoMap(flatAO->GetID());
-		defaultMaterial->setRoughnessMap(flatRoughness->GetID());
-		defaultMaterial->setMetallicMap(flatMetallic->GetID());
+		defaultMaterial->SetMap(TextureMapType::Albedo, flatDiffuse);
+		defaultMaterial->SetMap(TextureMapType::Normal, flatNormal);
+		defaultMaterial->SetMap(TextureMapType::AO, flatAO);
+		defaultMaterial->SetMap(TextureMapType::Roughness, flatRoughness);
+		defaultMaterial->SetMap(TextureMapType::Metallic, flatMetallic);
 
 		defaultMaterial->setColor(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
 
@@ -101,6 +115,125 @@ namespace Iaonnis
 
 	}
 
+	void ResourceCache::rename(UUID id, const std::string& name)
+	{
+		std::shared_ptr<Resource> resource = GetByUUID<Resource>(id);
+		if (!resource)
+		{
+			IAONNIS_LOG_ERROR("Failed to find resource. (UUID = %s)", UUIDFactory::uuidToString(id).c_str());
+			return;
+		}
+
+		std::unique_lock<std::shared_mutex> lock(index.mutex);
+		RemoveNameFromIndex(*resource);
+		resource->setName(name);
+		index.names.emplace(resource->GetNameId(), id);
+	}
+
+	void ResourceCache::SetPath(Resource& resource, const filespace::filepath& path)
+	{
+		std::unique_lock<std::shared_mutex> lock(index.mutex);
+
+		if (resource.GetPathId().IsValid())
+		{
+			auto it = index.paths.find(resource.GetPathId());
+			if (it != index.paths.end() && it->second == resource.GetID())
+				index.paths.erase(it);
+		}
+		RemoveNameFromIndex(resource);
+
+		resource.setPath(path);
+		resource.setName(filespace::getStem(path));
+
+		index.paths.try_emplace(resource.GetPathId(), resource.GetID());
+		index.names.emplace(resource.GetNameId(), resource.GetID());
+	}
+
+	ResourceCache::LoadClaim ResourceCache::ClaimPath(const filespace::filepath& path)
+	{
+		LoadClaim claim;
+		claim.pathId = Resource::InternPath(path);
+
+		UUID id;
+		{
+			std::unique_lock<std::shared_mutex> lock(index.mutex);
+
+			auto pending = index.claims.find(claim.pathId);
+			if (pending != index.claims.end())
+			{
+				claim.state = LoadClaim::State::Loading;
+				claim.pending = pending->second.second;
+				return claim;
+			}
+
+			auto it = index.paths.find(claim.pathId);
+			if (it == index.paths.end())
+			{
+				auto& [promise, future] = index.claims[claim.pathId];
+				future = promise.get_future().share();
+
+				claim.state = LoadClaim::State::Claimed;
+				return claim;
+			}
+
+			id = it->second;
+		}
+
+		claim.state = LoadClaim::State::Cached;
+		claim.existing = GetByUUID<Resource>(id);
+		return claim;
+	}
+
+	void ResourceCache::ResolveClaim(StringId pathId, std::shared_ptr<Resource> resource)
+	{
+		std::promise<std::shared_ptr<Resource>> promise;
+		{
+			std::unique_lock<std::shared_mutex> lock(index.mutex);
+			auto it = index.claims.find(pathId);
+			if (it == index.claims.end())
+				return;
+
+			promise = std::move(it->second.first);
+			index.claims.erase(it);
+		}
+
+		//The path is already indexed, later loads find the resource instead of the claim.
+		promise.set_value(std::move(resource));
+	}
+
+	std::shared_ptr<Resource> ResourceCache::WaitForLoad(const PendingLoad& pending)
+	{
+		while (pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			bool progressed = false;
+			if (GPUCommandQueue::IsGLThread() && GPUCommandQueue::GetPendingCount() > 0)
+			{
+				GPUCommandQueue::Execute(0.0);
+				progressed = true;
+			}
+			else
+				progressed = JobSystem::RunPendingJob();
+
+			if (!progressed)
+				std::this_thread::yield();
+		}
+
+		return pending.get();
+	}
+
+	void ResourceCache::RemoveNameFromIndex(const Resource& resource)
+	{
+		auto [begin, end] = index.names.equal_range(resource.GetNameId());
+		for (auto it = begin; it != end; ++it)
+		{
+			if (it->second == resource.GetID())
+			{
+				index.names.erase(it);
+				return;
+			}
+		}
+	}
+
 	std::shared_ptr<Material> ResourceCache::CreateNewMaterial(const std::string& name)
 	{
 
@@ -109,11 +242,11 @@ namespace Iaonnis
 
 		std::shared_ptr<Material> newResource = create<Material>(resourcePath);
 
-		newResource->setDiffuseMap(flatDiffuse->GetID());
-		newResource->setNormalMap(flatNormal->GetID());
-		newResource->setAoMap(flatAO->GetID());
-		newResource->setRoughnessMap(flatRoughness->GetID());
-		newResource->setMetallicMap(flatMetallic->GetID());
+		newResource->SetMap(TextureMapType::Albedo, flatDiffuse);
+		newResource->SetMap(TextureMapType::Normal, flatNormal);
+		newResource->SetMap(TextureMapType::AO, flatAO);
+		newResource->SetMap(TextureMapType::Roughness, flatRoughness);
+		newResource->SetMap(TextureMapType::Metallic, flatMetallic);
 
 		newResource->setColor(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
 		return newResource;
@@ -7,6 +7,12 @@
 #include "ImageTexture.h"
 #include "Material.h"
 #include "Environment.h"
+#include "../Core/Task.h"
+#include "../GPU/GPUCommandQueue.h"
+
+#include <shared_mutex>
+
+#define IAONNIS_RESOURCE_CACHE_SHARDS 16
 
 namespace Iaonnis
 {
@@ -24,12 +30,13 @@ namespace Iaonnis
 
 	struct ResourceCacheMeta
 	{
-		int loadedResources;
+		std::atomic<int> loadedResources{ 0 };
 
-		size_t totalImageTextureSize;
+		std::atomic<size_t> totalImageTextureSize{ 0 };
 	};
 
-	class ResourceCache
+	/// @brief Owned through std::shared_ptr, pending loadAsync() calls hold a reference so the cache outlives them.
+	class ResourceCache : public std::enable_shared_from_this<ResourceCache>
 	{
 	public:
 		ResourceCache();
@@ -70,51 +77,98 @@ namespace Iaonnis
 		template<class T>
 		std::shared_ptr<T> getByPath(filespace::filepath path)
 		{
-			for (auto& [id, resource] : resources)
+			//A path that was never interned can not be cached.
+			StringId pathId = Resource::FindPath(path);
+			if (!pathId.IsValid())
+				return nullptr;
+
+			UUID id;
 			{
-				if (resource->getPath() == path)
-				{
-					return std::static_pointer_cast<T>(resource);
-				}
+				std::shared_lock<std::shared_mutex> lock(index.mutex);
+				auto it = index.paths.find(pathId);
+				if (it == index.paths.end())
+					return nullptr;
+
+				id = it->second;
 			}
 
-			//IAONNIS_LOG_ERROR("Failed to find resource. (Path = %s)", path.string().c_str());
-			return nullptr;
+			return GetByUUID<T>(id);
 		}
 
 		//Avoid getting by name. Only use when you can are sure the asset/resource is the only one with that name.
 		template<class T>
 		std::shared_ptr<T> GetByName(const std::string& name)
 		{
-			for (auto& [id, resource] : resources)
+			StringId nameId = StringId::Find(name);
+			if (!nameId.IsValid())
+				return nullptr;
+
+			std::shared_lock<std::shared_mutex> lock(index.mutex);
+			auto [begin, end] = index.names.equal_range(nameId);
+			for (auto it = begin; it != end; ++it)
 			{
-				if (resource->getName() == name)
-					return std::static_pointer_cast<T>(resource);
+				//Names are shared across types, e.g. the Cube mesh and a material called Cube.
+				std::shared_ptr<T> resource = std::dynamic_pointer_cast<T>(GetByUUID<Resource>(it->second));
+				if (resource)
+					return resource;
 			}
 
 			//IAONNIS_LOG_ERROR("Failed to find resource. (Name = %s)", name.c_str());
 			return nullptr;
 		}
 
+		/// @brief Renames a cached resource and keeps the name index in step.
+		void rename(UUID id, const std::string& name);
+
+		/// @brief Every cached Mesh, Material or ImageTexture, straight from its pool. Nothing is copied; the view locks
+		/// the pool against adds and removes for as long as it lives, so scope it to one loop and do not cache
+		/// resources or call out to user code while iterating it.
 		template<class T>
-		std::vector<std::shared_ptr<T>> getByType(ResourceType type)
+		ResourcePoolView<T> getByType()const
 		{
-			std::vector<std::shared_ptr<T>> res;
-			for (auto& [id, resource] : resources)
-			{
-				if (resource->getType() == type)
-					res.push_back(std::static_pointer_cast<T>(resource));
-			}
+			return GetPool<T>().View();
+		}
+
+		/// @brief Changes whenever a resource of type T is cached or removed. Remember it to skip work when it has not.
+		template<class T>
+		uint64_t GetVersion()const
+		{
+			return GetPool<T>().GetVersion();
+		}
 
-			return res;
+		/// @brief Pool lookup, no locking and no reference counting. nullptr if the handle is stale.
+		template<class T>
+		T* Get(ResourceHandle<T> handle)const
+		{
+			return GetPool<T>().Get(handle);
+		}
+
+		/// @brief Mesh, Material and ImageTexture resources are also kept in a dense pool per type.
+		template<class T>
+		ResourcePool<T>& GetPool()
+		{
+			static_assert(std::is_same_v<T, Mesh> || std::is_same_v<T, Material> || std::is_same_v<T, ImageTexture>, "Resource type has no pool.");
+			if constexpr (std::is_same_v<T, Mesh>) return meshPool;
+			else if constexpr (std::is_same_v<T, Material>) return materialPool;
+			else return imageTexturePool;
+		}
+
+		template<class T>
+		const ResourcePool<T>& GetPool()const
+		{
+			return const_cast<ResourceCache*>(this)->GetPool<T>();
 		}
 
 		template<class T>
 		std::shared_ptr<T> GetByUUID(UUID id)
 		{
-			if (resources.find(id) != resources.end())
+			auto& shard = GetShard(id);
+			std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+			auto it = shard.resources.find(id);
+			if (it != shard.resources.end())
 			{
-				return std::static_pointer_cast<T>(resources[id]);
+				return std::static_pointer_cast<T>(it->second);
 			}
 
 			//IAONNIS_LOG_ERROR("Failed to find resource. (UUID = %s)", UUIDFactory::uuidToString(id).c_str());
@@ -132,32 +186,167 @@ namespace Iaonnis
 		template<class T>
 		std::shared_ptr<T> load(filespace::filepath path)
 		{
-			STIMER_START(loadTime);
+			IAONNIS_PROFILE_SCOPE("ResourceCache::load");
 			if (!filespace::exists(path))
 			{
 				IAONNIS_LOG_ERROR("Invalid path provided. (Path = %s)", path.string().c_str());
 				return nullptr;
 			}
 
-			std::shared_ptr<T> existing = getByPath<T>(path);
-			if (existing)
+			LoadClaim claim = ClaimPath(path);
+			if (claim.state == LoadClaim::State::Cached)
 			{
 				IAONNIS_LOG_ERROR("Resource has already been cached. (Path = %s)", path.string().c_str());
-				return std::static_pointer_cast<T>(existing);
+				return std::static_pointer_cast<T>(claim.existing);
 			}
+			if (claim.state == LoadClaim::State::Loading)
+				return std::static_pointer_cast<T>(WaitForLoad(claim.pending));
 			
 			std::shared_ptr<T> newResource = std::make_shared<T>();
 			newResource->load(path);
-			cache(path, newResource);
+			ReleaseClaim(claim, path, newResource);
 
 			meta.loadedResources++;
-
-			STIMER_STOP(loadTime);
-			STIMER_PRINT(loadTime);
 			return newResource;
 		}
 
 
+		/// @brief Reads every file in one IOService batch and then builds the resources in order.
+		/// The result matches paths, entries that failed to load are nullptr.
+		template<class T>
+		std::vector<std::shared_ptr<T>> loadBatch(const std::vector<filespace::filepath>& paths)
+		{
+			std::vector<std::shared_ptr<T>> loaded(paths.size());
+			std::vector<filespace::filepath> pendingPaths;
+			std::vector<size_t> pendingIndices;
+			std::vector<LoadClaim> pendingClaims;
+
+			//Paths another load claimed first, collected once this batch has released its own claims.
+			std::vector<std::pair<size_t, PendingLoad>> waiting;
+
+			for (size_t i = 0; i < paths.size(); i++)
+			{
+				if (!filespace::exists(paths[i]))
+				{
+					IAONNIS_LOG_ERROR("Invalid path provided. (Path = %s)", paths[i].string().c_str());
+					continue;
+				}
+
+				LoadClaim claim = ClaimPath(paths[i]);
+				if (claim.state == LoadClaim::State::Cached)
+				{
+					loaded[i] = std::static_pointer_cast<T>(claim.existing);
+					continue;
+				}
+				if (claim.state == LoadClaim::State::Loading)
+				{
+					waiting.emplace_back(i, claim.pending);
+					continue;
+				}
+
+				pendingPaths.push_back(paths[i]);
+				pendingIndices.push_back(i);
+				pendingClaims.push_back(std::move(claim));
+			}
+
+			std::vector<IOResult> files = IOService::ReadFiles(pendingPaths);
+			for (size_t i = 0; i < files.size(); i++)
+			{
+				const filespace::filepath& path = pendingPaths[i];
+				if (!files[i].Succeeded())
+				{
+					IAONNIS_LOG_ERROR("Failed to read resource. (Path = %s)", path.string().c_str());
+					ReleaseClaim(pendingClaims[i], path, std::shared_ptr<T>());
+					continue;
+				}
+
+				std::shared_ptr<T> newResource = std::make_shared<T>();
+				newResource->loadFromMemory(path, files[i].buffer);
+				ReleaseClaim(pendingClaims[i], path, newResource);
+
+				meta.loadedResources++;
+				loaded[pendingIndices[i]] = newResource;
+			}
+
+			for (auto& [i, pending] : waiting)
+				loaded[i] = std::static_pointer_cast<T>(WaitForLoad(pending));
+
+			return loaded;
+		}
+
+		/// @brief Loads a resource without blocking the calling thread.
+		/// The file is read by IOService, decoded on a worker and cached on the GL thread once every upload it queued
+		/// has run, which is also where the awaiting coroutine resumes. Returns nullptr on failure or when token was
+		/// cancelled, in which case the requester is not touched again. Requests for a path that is already loading
+		/// wait for that load on a worker and share its result, nullptr if it failed or was cancelled.
+		/// The coroutine keeps the cache alive until it finishes, the owner may drop it while a load is in flight.
+		template<class T>
+		Task<std::shared_ptr<T>> loadAsync(filespace::filepath path, CancellationToken token = {})
+		{
+			std::shared_ptr<ResourceCache> keepAlive = shared_from_this();
+
+			std::shared_ptr<T> existing = getByPath<T>(path);
+			if (existing)
+				co_return existing;
+
+			if (!filespace::exists(path))
+			{
+				IAONNIS_LOG_ERROR("Invalid path provided. (Path = %s)", path.string().c_str());
+				co_return nullptr;
+			}
+
+			LoadClaim claim = ClaimPath(path);
+			if (claim.state == LoadClaim::State::Cached)
+				co_return std::static_pointer_cast<T>(claim.existing);
+
+			if (claim.state == LoadClaim::State::Loading)
+			{
+				co_await ResumeOnWorker();
+				std::shared_ptr<Resource> loaded = WaitForLoad(claim.pending);
+				co_await GPUCommandQueue::ResumeOnGLThread();
+				if (token.IsCancelled())
+					co_return nullptr;
+				co_return std::static_pointer_cast<T>(loaded);
+			}
+
+			IOResult file = co_await ReadFileAwaiter(path);
+
+			co_await ResumeOnWorker();
+
+			std::shared_ptr<T> newResource;
+			if (file.Succeeded() && !token.IsCancelled())
+			{
+				IAONNIS_PROFILE_SCOPE("ResourceCache::loadAsync Decode");
+				newResource = std::make_shared<T>();
+				newResource->loadFromMemory(path, file.buffer);
+				file.buffer = {};
+			}
+
+			co_await GPUCommandQueue::ResumeOnGLThread();
+
+			if (token.IsCancelled())
+			{
+				ReleaseClaim(claim, path, std::shared_ptr<T>());
+				co_return nullptr;
+			}
+
+			if (!newResource)
+			{
+				IAONNIS_LOG_ERROR("Failed to read resource. (Path = %s)", path.string().c_str());
+				ReleaseClaim(claim, path, std::shared_ptr<T>());
+				co_return nullptr;
+			}
+
+			ReleaseClaim(claim, path, newResource);
+			meta.loadedResources++;
+
+			ResourceLoadedEvent loadedEvent;
+			loadedEvent.resourceID = newResource->GetID();
+			EventQueue::post(loadedEvent);
+
+			co_return newResource;
+		}
+
 		template<class T>
 		std::shared_ptr<T> duplicate(UUID originalResourceID)
 		{
@@ -175,20 +364,26 @@ namespace Iaonnis
 			return newResource;
 		}
 
+		/// @brief Saves the resource called name to path and moves it there in the index.
 		template<class T>
 		void save(const std::string& name, filespace::filepath path)
 		{
-			std::shared_ptr<T> existing = getByPath<T>(path);
-			if (existing)
+			std::shared_ptr<T> resource = GetByName<T>(name);
+			if (!resource)
 			{
-				IAONNIS_LOG_ERROR("Resource has already been cached. (Path = %s)", path.string().c_str());
-				return std::static_pointer_cast<T>(existing);
+				IAONNIS_LOG_ERROR("Failed to find resource. (Name = %s)", name.c_str());
+				return;
 			}
 
-			existing->setPath(path);
-			existing->setName(filespace::getStem(path));
-			
-			existing->save(path);
+			std::shared_ptr<Resource> existing = getByPath<Resource>(path);
+			if (existing && existing != resource)
+			{
+				IAONNIS_LOG_ERROR("Path is used by another resource. (Path = %s)", path.string().c_str());
+				return;
+			}
+
+			SetPath(*resource, path);
+			resource->save(path);
 		}
 
 
@@ -199,7 +394,7 @@ namespace Iaonnis
 			auto resource = GetByUUID<T>(id);
 			if (resource == nullptr)
 			{
-				IAONNIS_LOG_ERROR("Failed to find resource. (UUID = %s)", UUIDFactory::uuidToString(id));
+				IAONNIS_LOG_ERROR("Failed to find resource. (UUID = %s)", UUIDFactory::uuidToString(id).c_str());
 				return;
 			}
 
@@ -212,7 +407,7 @@ namespace Iaonnis
 			auto resource = GetByUUID<T>(id);
 			if (resource == nullptr)
 			{
-				IAONNIS_LOG_ERROR("Failed to find resource. (Name = %s)", UUIDFactory::uuidToString(id));
+				IAONNIS_LOG_ERROR("Failed to find resource. (UUID = %s)", UUIDFactory::uuidToString(id).c_str());
 				return;
 			}
 
@@ -235,10 +430,10 @@ namespace Iaonnis
 			{
 				UUID id = UUIDFactory::generateUUID();
 				resource->setUUID(id);
-				resource->setPath(path);
-				resource->setName(filespace::getStem(path));
 
-				resources[id] = resource;
+				AddToPool(resource);
+				Insert(id, resource);
+				SetPath(*resource, path);
 			}
 
 			template<class T>
@@ -247,10 +442,106 @@ namespace Iaonnis
 				UUID id = UUIDFactory::generateUUID();
 				resource->setUUID(id);
 
-				resources[id] = resource;
+				AddToPool(resource);
+				Insert(id, resource);
+
+				if (resource->GetNameId().IsValid())
+				{
+					std::unique_lock<std::shared_mutex> lock(index.mutex);
+					index.names.emplace(resource->GetNameId(), id);
+				}
+			}
+
+			using PendingLoad = std::shared_future<std::shared_ptr<Resource>>;
+
+			/// @brief Outcome of ClaimPath(). Claimed makes the caller the only loader of the path until ReleaseClaim().
+			struct LoadClaim
+			{
+				enum class State
+				{
+					Cached,
+					Loading,
+					Claimed
+				};
+
+				State state = State::Claimed;
+				StringId pathId;
+
+				/// @brief Set when Cached.
+				std::shared_ptr<Resource> existing;
+
+				/// @brief Set when Loading, resolves to the claiming load's resource or nullptr if it failed.
+				PendingLoad pending;
+			};
+
+			/// @brief Looks the path up and, if it is neither cached nor being loaded, claims it under the same lock,
+			/// so two threads loading one path never both load and cache it.
+			LoadClaim ClaimPath(const filespace::filepath& path);
+
+			/// @brief Caches resource under path, unless it is null because the load failed, then ends the claim and
+			/// hands the result to every load waiting on it.
+			template<class T>
+			void ReleaseClaim(const LoadClaim& claim, const filespace::filepath& path, const std::shared_ptr<T>& resource)
+			{
+				if (resource)
+					cache(path, resource);
+
+				ResolveClaim(claim.pathId, resource);
 			}
+
+			void ResolveClaim(StringId pathId, std::shared_ptr<Resource> resource);
+
+			/// @brief Blocks until a claimed load finishes. The claiming load may need this thread, so GL commands
+			/// are run on the GL thread and jobs everywhere else while waiting.
+			static std::shared_ptr<Resource> WaitForLoad(const PendingLoad& pending);
+
+			template<class T>
+			void AddToPool(const std::shared_ptr<T>& resource)
+			{
+				if constexpr (std::is_same_v<T, Mesh> || std::is_same_v<T, Material> || std::is_same_v<T, ImageTexture>)
+					resource->setPoolHandle(GetPool<T>().Add(resource).value);
+			}
+
+			struct Shard
+			{
+				std::shared_mutex mutex;
+				std::unordered_map<UUID, std::shared_ptr<Resource>> resources;
+			};
+
+			Shard& GetShard(const UUID& id)
+			{
+				return shards[(size_t)HashUUID(id) & (IAONNIS_RESOURCE_CACHE_SHARDS - 1)];
+			}
+
+			void Insert(const UUID& id, std::shared_ptr<Resource> resource)
+			{
+				auto& shard = GetShard(id);
+				std::unique_lock<std::shared_mutex> lock(shard.mutex);
+				shard.resources[id] = std::move(resource);
+			}
+
+			/// @brief Sets the path and the name derived from it, moving the resource's index entries along.
+			void SetPath(Resource& resource, const filespace::filepath& path);
+			void RemoveNameFromIndex(const Resource& resource);
+
+			/// @brief Interned path and name -> UUID. Equal names are allowed, the first resource holding a path keeps it.
+			struct Index
+			{
+				std::shared_mutex mutex;
+				std::unordered_map<StringId, UUID> paths;
+				std::unordered_multimap<StringId, UUID> names;
+
+				/// @brief Paths claimed by a load that has not been cached yet.
+				std::unordered_map<StringId, std::pair<std::promise<std::shared_ptr<Resource>>, PendingLoad>> claims;
+			};
 	private:
-		std::unordered_map <UUID, std::shared_ptr<Resource>>resources;
+		//Lookups by UUID lock a single shard for reading, scans visit the shards one at a time.
+		std::array<Shard, IAONNIS_RESOURCE_CACHE_SHARDS> shards;
+		Index index;
+
+		ResourcePool<Mesh> meshPool;
+		ResourcePool<Material> materialPool;
+		ResourcePool<ImageTexture> imageTexturePool;
 
 		ResourceCacheMeta meta;
 	};
@@ -0,0 +1,249 @@
+#pragma once
+#include "../Core/pch.h"
+#include "../Core/Defines.h"
+
+#include <atomic>
+#include <shared_mutex>
+
+namespace Iaonnis
+{
+#define IAONNIS_RESOURCE_HANDLE_INDEX_BITS 20
+#define IAONNIS_RESOURCE_HANDLE_GENERATION_BITS 12
+#define IAONNIS_RESOURCE_POOL_CHUNK_SIZE 4096
+
+	/// @brief 32 bit reference into a ResourcePool: the low bits are the slot index, the high bits the slot generation.
+	/// A handle whose generation no longer matches the slot refers to a resource that has been removed.
+	/// The value 0 is never handed out and means "no resource".
+	template<class T>
+	struct ResourceHandle
+	{
+		static constexpr uint32_t INDEX_MASK = (1u << IAONNIS_RESOURCE_HANDLE_INDEX_BITS) - 1;
+		static constexpr uint32_t GENERATION_MASK = (1u << IAONNIS_RESOURCE_HANDLE_GENERATION_BITS) - 1;
+
+		uint32_t value = 0;
+
+		ResourceHandle() = default;
+		explicit ResourceHandle(uint32_t value) :value(value) {}
+		ResourceHandle(uint32_t index, uint32_t generation)
+			:value((index & INDEX_MASK) | ((generation & GENERATION_MASK) << IAONNIS_RESOURCE_HANDLE_INDEX_BITS)) {}
+
+		uint32_t GetIndex()const { return value & INDEX_MASK; }
+		uint32_t GetGeneration()const { return value >> IAONNIS_RESOURCE_HANDLE_INDEX_BITS; }
+
+		bool IsValid()const { return value != 0; }
+
+		bool operator==(const ResourceHandle& other)const { return value == other.value; }
+		bool operator!=(const ResourceHandle& other)const { return value != other.value; }
+	};
+
+	/// <summary>
+	/// Non-owning range over the dense array of a ResourcePool, yields T&. Iterating it neither allocates nor touches
+	/// reference counts. The view holds the pool's read lock, so resources can not be added to or removed from the pool
+	/// while it is alive: keep it to the scope of one loop.
+	/// </summary>
+	template<class T>
+	class ResourcePoolView
+	{
+	public:
+		class Iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using pointer = T*;
+			using reference = T&;
+
+			Iterator() = default;
+			explicit Iterator(const std::shared_ptr<T>* current) :current(current) {}
+
+			T& operator*()const { return **current; }
+			T* operator->()const { return current->get(); }
+
+			Iterator& operator++() { ++current; return *this; }
+			Iterator operator++(int) { Iterator it = *this; ++current; return it; }
+
+			bool operator==(const Iterator& other)const { return current == other.current; }
+			bool operator!=(const Iterator& other)const { return current != other.current; }
+
+		private:
+			const std::shared_ptr<T>* current = nullptr;
+		};
+
+		ResourcePoolView(std::shared_mutex& mutex, const std::vector<std::shared_ptr<T>>& resources)
+			:lock(mutex), first(resources.data()), last(resources.data() + resources.size()) {}
+
+		Iterator begin()const { return Iterator(first); }
+		Iterator end()const { return Iterator(last); }
+
+		size_t size()const { return (size_t)(last - first); }
+		bool empty()const { return first == last; }
+
+		T& operator[](size_t i)const { return *first[i]; }
+
+	private:
+		std::shared_lock<std::shared_mutex> lock;
+		const std::shared_ptr<T>* first;
+		const std::shared_ptr<T>* last;
+	};
+
+	/// <summary>
+	/// Owns every resource of one type. Resources live in a dense array for iteration, handles go through a slot table.
+	/// Slots sit in fixed chunks that are never moved, so Get() is lock free from any thread.
+	/// Add and Remove are serialized, Remove must not race with readers of the removed resource.
+	/// Both bump the pool version, so a caller that remembers it can tell whether the set of resources changed.
+	/// </summary>
+	template<class T>
+	class ResourcePool
+	{
+	public:
+		static constexpr uint32_t MAX_CHUNKS = (1u << IAONNIS_RESOURCE_HANDLE_INDEX_BITS) / IAONNIS_RESOURCE_POOL_CHUNK_SIZE;
+
+		ResourcePool() = default;
+		ResourcePool(const ResourcePool&) = delete;
+		ResourcePool& operator=(const ResourcePool&) = delete;
+
+		~ResourcePool()
+		{
+			for (auto& chunk : chunks)
+				delete[] chunk.load(std::memory_order_relaxed);
+		}
+
+		ResourceHandle<T> Add(std::shared_ptr<T> resource)
+		{
+			std::unique_lock<std::shared_mutex> lock(mutex);
+
+			uint32_t index;
+			if (!freeSlots.empty())
+			{
+				index = freeSlots.back();
+				freeSlots.pop_back();
+			}
+			else
+			{
+				//Index 0 is skipped so that no valid handle can have the value 0.
+				index = ++slotCount;
+				IAONNIS_ASSERT(index <= ResourceHandle<T>::INDEX_MASK, "Resource pool is full.");
+
+				auto& chunk = chunks[index / IAONNIS_RESOURCE_POOL_CHUNK_SIZE];
+				if (!chunk.load(std::memory_order_relaxed))
+					chunk.store(new Slot[IAONNIS_RESOURCE_POOL_CHUNK_SIZE], std::memory_order_release);
+			}
+
+			Slot& slot = GetSlot(index);
+			uint32_t generation = (slot.generation.load(std::memory_order_relaxed) + 1) & ResourceHandle<T>::GENERATION_MASK;
+			if (generation == 0)
+				generation = 1;
+
+			slot.denseIndex = (uint32_t)resources.size();
+			slot.resource.store(resource.get(), std::memory_order_relaxed);
+			slot.generation.store(generation, std::memory_order_release);
+
+			resources.push_back(std::move(resource));
+			denseToSlot.push_back(index);
+			version.fetch_add(1, std::memory_order_release);
+
+			return ResourceHandle<T>(index, generation);
+		}
+
+		void Remove(ResourceHandle<T> handle)
+		{
+			std::unique_lock<std::shared_mutex> lock(mutex);
+			if (!IsAlive(handle))
+				return;
+
+			Slot& slot = GetSlot(handle.GetIndex());
+			slot.generation.store((handle.GetGeneration() + 1) & ResourceHandle<T>::GENERATION_MASK, std::memory_order_release);
+			slot.resource.store(nullptr, std::memory_order_relaxed);
+
+			//Swap the last resource into the hole so the dense array stays packed.
+			uint32_t hole = slot.denseIndex;
+			uint32_t last = (uint32_t)resources.size() - 1;
+			if (hole != last)
+			{
+				resources[hole] = std::move(resources[last]);
+				denseToSlot[hole] = denseToSlot[last];
+				GetSlot(denseToSlot[hole]).denseIndex = hole;
+			}
+			resources.pop_back();
+			denseToSlot.pop_back();
+
+			freeSlots.push_back(handle.GetIndex());
+			version.fetch_add(1, std::memory_order_release);
+		}
+
+		/// @brief nullptr if the handle is null or stale.
+		T* Get(ResourceHandle<T> handle)const
+		{
+			if (!IsAlive(handle))
+				return nullptr;
+
+			return GetSlot(handle.GetIndex()).resource.load(std::memory_order_relaxed);
+		}
+
+		bool IsAlive(ResourceHandle<T> handle)const
+		{
+			uint32_t index = handle.GetIndex();
+			if (!handle.IsValid() || index / IAONNIS_RESOURCE_POOL_CHUNK_SIZE >= MAX_CHUNKS)
+				return false;
+
+			Slot* chunk = chunks[index / IAONNIS_RESOURCE_POOL_CHUNK_SIZE].load(std::memory_order_acquire);
+			if (!chunk)
+				return false;
+
+			return chunk[index % IAONNIS_RESOURCE_POOL_CHUNK_SIZE].generation.load(std::memory_order_acquire) == handle.GetGeneration();
+		}
+
+		/// @brief Visits every resource in dense order. Resources may not be added or removed from inside function.
+		template<class Function>
+		void ForEach(Function&& function)const
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+			for (size_t i = 0; i < resources.size(); i++)
+				function(*resources[i], ResourceHandle<T>(denseToSlot[i], GetSlot(denseToSlot[i]).generation.load(std::memory_order_relaxed)));
+		}
+
+		/// @brief Every resource in dense order, see ResourcePoolView.
+		ResourcePoolView<T> View()const
+		{
+			return ResourcePoolView<T>(mutex, resources);
+		}
+
+		size_t Size()const
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+			return resources.size();
+		}
+
+		/// @brief Changes whenever a resource is added or removed, never when one is only modified.
+		uint64_t GetVersion()const
+		{
+			return version.load(std::memory_order_acquire);
+		}
+
+	private:
+		struct Slot
+		{
+			std::atomic<uint32_t> generation{ 0 };
+			std::atomic<T*> resource{ nullptr };
+			uint32_t denseIndex = 0;
+		};
+
+		Slot& GetSlot(uint32_t index)const
+		{
+			return chunks[index / IAONNIS_RESOURCE_POOL_CHUNK_SIZE].load(std::memory_order_acquire)[index % IAONNIS_RESOURCE_POOL_CHUNK_SIZE];
+		}
+
+	private:
+		mutable std::shared_mutex mutex;
+
+		std::atomic<Slot*> chunks[MAX_CHUNKS] = {};
+		uint32_t slotCount = 0;
+		std::vector<uint32_t> freeSlots;
+
+		std::vector<std::shared_ptr<T>> resources;
+		std::vector<uint32_t> denseToSlot;
+
+		std::atomic<uint64_t> version{ 0 };
+	};
+}
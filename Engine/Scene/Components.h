@@ -3,9 +3,12 @@
 #include "../Core/pch.h"
 
 #include "Camera.h"
+#include "../Resource/ResourceHandle.h"
 
 namespace Iaonnis
 {
+	class Mesh;
+
 	struct DerivedComponent
 	{
 		bool active = true;
@@ -27,7 +30,7 @@ namespace Iaonnis
 
 	struct TagComponent : public DerivedComponent
 	{
-		std::string tag;
+		StringId tag;
 
 		TagComponent()
 		{
@@ -35,7 +38,7 @@ namespace Iaonnis
 		};
 		TagComponent(std::string name)
 		{
-			tag = name;
+			tag = StringId(name);
 		}
 		TagComponent(const TagComponent& other) = default;
 	};
@@ -59,14 +62,17 @@ namespace Iaonnis
 
 	struct MeshFilterComponent : public DerivedComponent
 	{
+		//The UUID is only used for serialization, everything at runtime goes through the handle.
 		UUID meshID;
+		ResourceHandle<Mesh> mesh;
 
-		std::unordered_map<UUID, std::list<int>> materialIDMap;
-		std::vector<std::string> names;
+		//Material of every submesh, indexed like the mesh's submeshes.
+		std::vector<UUID> materials;
+		std::vector<StringId> names;
 
 		MeshFilterComponent() = default;
-		MeshFilterComponent(UUID id)
-			:meshID(id){ }
+		MeshFilterComponent(UUID id, ResourceHandle<Mesh> mesh)
+			:meshID(id), mesh(mesh){ }
 		MeshFilterComponent(const MeshFilterComponent& other) = default;
 	};
 
@@ -12,16 +12,22 @@ namespace Iaonnis
 	public:
 		Entity() = default;
 		Entity(entt::entity entity, Scene* scene)
-			:entity(entity), scene(scene), active(true)
+			:entity(entity), scene(scene)
 		{
 		}
 		Entity(const Entity& other) = default;
 
+		/// @brief False for a default constructed handle and once the entity is destroyed.
+		bool IsValid()const
+		{
+			return scene != nullptr && scene->registry.valid(entity);
+		}
+
 		entt::entity GetBaseEntity()
 		{
 			return entity;
 		}
-		glm::mat4 GetTransformMatrix()
+		glm::mat4 GetTransformMatrix()const
 		{
 			return GetComponent<TransformComponent>().model;
 		}
@@ -31,9 +37,9 @@ namespace Iaonnis
 			return scene->registry.get<IDComponent>(entity).id;
 		}
 
-		std::string GetTag()
+		const std::string& GetTag()
 		{
-			return GetComponent<TagComponent>().tag;
+			return GetComponent<TagComponent>().tag.str();
 		}
 
 		UUID GetSubMeshMaterial(int index)
@@ -45,45 +51,11 @@ namespace Iaonnis
 				return UUIDFactory::getInvalidUUID();
 			}
 
-			auto& meshFilter = GetComponent<MeshFilterComponent>();
-			auto& materialMap = meshFilter.materialIDMap;
-
-			for (auto& [mtl, deps] : materialMap)
-			{
-				for (auto dep : deps)
-				{
-					if (dep == index)
-						return mtl;
-				}
-			}
-
-			return UUIDFactory::getInvalidUUID();
-		}
-
-		void DettachUnusedMaterials()
-		{
-			if (!HasComponent<MeshFilterComponent>())
-			{
-				IAONNIS_LOG_ERROR("Cannot add material to entity without a mesh filter");
-				return;
-			}
-
-			auto& meshFilter = GetComponent<MeshFilterComponent>();
-			auto& materialMap = meshFilter.materialIDMap;
-
-			std::set<UUID>toClear;
-			for (auto& [matID, deps] : materialMap)
-			{
-				if(!deps.size())
-				{
-					toClear.insert(matID);
-				}
-			}
+			auto& materials = GetComponent<MeshFilterComponent>().materials;
+			if (index < 0 || index >= (int)materials.size())
+				return UUIDFactory::getInvalidUUID();
 
-			for(auto& c : toClear)
-			{
-				materialMap.erase(c);
-			}
+			return materials[index];
 		}
 
 		void AssignMaterial(UUID mtlID, int subMeshIndex)
@@ -94,15 +66,11 @@ namespace Iaonnis
 				return;
 			}
 
-			auto& meshFilter = GetComponent<MeshFilterComponent>();
-			auto& materialMap = meshFilter.materialIDMap;
+			auto& materials = GetComponent<MeshFilterComponent>().materials;
+			if (subMeshIndex >= (int)materials.size())
+				materials.resize(subMeshIndex + 1, UUIDFactory::getInvalidUUID());
 
-			for (auto& [matID, dependants] : materialMap)
-			{
-				dependants.remove(subMeshIndex);
-			}
-
-			meshFilter.materialIDMap[mtlID].push_back(subMeshIndex);
+			materials[subMeshIndex] = mtlID;
 			return;
 		}
 
@@ -162,29 +130,52 @@ namespace Iaonnis
 			}
 
 			auto& meshFilter = GetComponent<MeshFilterComponent>();
-			for (auto id : meshFilter.materialIDMap)
+			std::unordered_set<UUID> seen;
+			for (auto& id : meshFilter.materials)
 			{
-				ret.push_back(id.first);
+				if (id != UUIDFactory::getInvalidUUID() && seen.insert(id).second)
+					ret.push_back(id);
 			}
 
 			return ret;
 		}
 
-		int GetMaterialDependantCount(UUID mtl)
+		/// @brief Material -> submesh indices using it, in first-use order. Built on every call, meant for the inspector.
+		std::vector<std::pair<UUID, std::vector<int>>> GetMaterialUsers()
 		{
+			std::vector<std::pair<UUID, std::vector<int>>> ret;
 			if (!HasComponent<MeshFilterComponent>())
 			{
 				IAONNIS_LOG_ERROR("Entity does not have mesh filter.");
-				return -1;
+				return ret;
 			}
+
 			auto& meshFilter = GetComponent<MeshFilterComponent>();
-			
-			if (meshFilter.materialIDMap.find(mtl) == meshFilter.materialIDMap.end())
+			std::unordered_map<UUID, size_t> slots;
+			for (int i = 0; i < (int)meshFilter.materials.size(); i++)
 			{
-				return 0;
+				UUID id = meshFilter.materials[i];
+				if (id == UUIDFactory::getInvalidUUID())
+					continue;
+
+				auto [it, inserted] = slots.try_emplace(id, ret.size());
+				if (inserted)
+					ret.emplace_back(id, std::vector<int>());
+				ret[it->second].second.push_back(i);
 			}
 
-			return meshFilter.materialIDMap[mtl].size();
+			return ret;
+		}
+
+		int GetMaterialDependantCount(UUID mtl)
+		{
+			if (!HasComponent<MeshFilterComponent>())
+			{
+				IAONNIS_LOG_ERROR("Entity does not have mesh filter.");
+				return -1;
+			}
+			auto& meshFilter = GetComponent<MeshFilterComponent>();
+			return (int)std::count(meshFilter.materials.begin(), meshFilter.materials.end(), mtl);
 		}
 		
 
@@ -206,26 +197,39 @@ namespace Iaonnis
 			return scene->registry.get<T>(entity);
 		}
 
+		/// @brief Read-only access through the registry's const interface, safe from concurrent read-only stages.
+		template<typename T>
+		const T& GetComponent()const
+		{
+			return std::as_const(scene->registry).get<T>(entity);
+		}
+
 		template<typename T> 
 		void RemoveComponent()
 		{
 			return scene->registry.remove<T>(entity);
 		}
 
-		bool* GetActive() { return &active; }
+		/// @brief Inactive entities stay in the scene but are not rendered.
+		bool IsActive()const { return GetComponent<IDComponent>().active; }
+		bool* GetActive() { return &GetComponent<IDComponent>().active; }
 
 		bool operator==(const Entity& other)const
 		{
 			return entity == other.entity;
 		}
 
-		bool active;
-	protected:
-		Entity* parent = nullptr;
-		std::vector<Entity*> children;
-		
 	private:
-		entt::entity entity;
-		Scene* scene;
+		entt::entity entity = entt::null;
+		Scene* scene = nullptr;
 	};
+
+	template<typename Function>
+	void Scene::EachEntity(Function&& function)
+	{
+		//Indexed so the function may remove the entity it is given; the last entity moves into its slot and is visited next frame.
+		const entt::sparse_set& ids = registry.storage<IDComponent>();
+		for (size_t i = 0; i < ids.size(); i++)
+			function(Entity(ids[i], this));
+	}
 }
\ No newline at end of file
@@ -8,6 +8,17 @@ namespace Iaonnis
     Iaonnis::Scene::Scene(const std::string& name)
         :cache(cache),name(name), displaySize(glm::vec2(800.0f, 800.0f))
     {
+        IAONNIS_MEMORY_TAG(MemoryTag::Scene);
+
+        //Every pool exists before the first frame. Read-only stages run side by side on workers, and a lookup that
+        //had to create a missing pool would modify the registry under them.
+        registry.storage<IDComponent>();
+        registry.storage<TagComponent>();
+        registry.storage<TransformComponent>();
+        registry.storage<MeshFilterComponent>();
+        registry.storage<CameraComponent>();
+        registry.storage<LightComponent>();
+
         cache = std::make_shared<ResourceCache>();
         camera = std::make_shared<Camera>("Main Camera", glm::vec3(3.0f, 3.0f, 8.0f), displaySize.x, displaySize.y);
         environment = cache->load<Environment>("Assets/Environment Maps/Skybox/skybox.txt");
@@ -26,39 +37,41 @@ namespace Iaonnis
         //Systems Init()
         systems.emplace_back(std::make_unique<TransformSystem>(&registry));
 
-        EventBus::subscribe(EventType::RESIZE_EVENT, std::bind(&Scene::OnViewFrameResize, this, std::placeholders::_1));
+        resizeListener = EventBus::subscribe<FrameResizeEvent, &Scene::OnViewFrameResize>(this);
     }
 
     Scene::~Scene()
     {
-
+        EventBus::unsubscribe(resizeListener);
     }
 
     void Scene::OnUpdate(float dt)
     {
+        IAONNIS_ASSERT_NO_ALLOCATIONS("Scene::OnUpdate");
         for (auto& system : systems)
             system->OnUpdate(dt);
     }
 
-    Entity& Iaonnis::Scene::CreateEntity(const std::string& name)
+    Entity Iaonnis::Scene::CreateEntity(const std::string& name)
     {
+        IAONNIS_MEMORY_TAG(MemoryTag::Scene);
         Entity entity{ registry.create(),this};
 
-        entity.AddComponent<IDComponent>();
+        UUID id = entity.AddComponent<IDComponent>().id;
         entity.AddComponent<TagComponent>(name);
         entity.AddComponent<TransformComponent>();
 
-        entities.push_back(entity);
+        entityIndex.emplace(id, entity.GetBaseEntity());
 
         OnEntityRegisteryModified();
         OnMaterialModified();
 
-        return entities.back();
+        return entity;
     }
 
-    Entity& Scene::CreateCamera(const std::string& name)
+    Entity Scene::CreateCamera(const std::string& name)
     {
-        Entity& entity = CreateEntity(name);
+        Entity entity = CreateEntity(name);
         auto camera = std::make_shared<Camera>(name, glm::vec3(0.0f, -2.0f, -5.0f), displaySize.x, displaySize.y);
         auto& camComp = entity.AddComponent<CameraComponent>();
         camComp.camera = camera;
@@ -67,15 +80,16 @@ namespace Iaonnis
         return entity;
     }
 
-    Entity& Scene::addMesh(filespace::filepath path, const std::string& name)
+    Entity Scene::addMesh(filespace::filepath path, const std::string& name)
     {
         std::shared_ptr<Mesh> meshResource = cache->load<Mesh>(path);
         int subMeshCount = meshResource->getSubMeshCount();
         UUID defaultMaterialID = cache->GetDefaultMaterial()->GetID();
 
-        Entity& entity = CreateEntity(meshResource->getName());
-        auto& meshFilterComp = entity.AddComponent<MeshFilterComponent>(meshResource->GetID());
+        Entity entity = CreateEntity(meshResource->getName());
+        auto& meshFilterComp = entity.AddComponent<MeshFilterComponent>(meshResource->GetID(), meshResource->GetHandle<Mesh>());
         meshFilterComp.names.resize(subMeshCount);
+        meshFilterComp.materials.resize(subMeshCount, UUIDFactory::getInvalidUUID());
         
         for (int i = 0; i < subMeshCount; i++)
         {
@@ -86,15 +100,25 @@ namespace Iaonnis
         return entity;
     }
 
-    Entity& Scene::addMesh(UUID meshID)
+    Task<void> Scene::addMeshAsync(filespace::filepath path)
+    {
+        std::shared_ptr<Mesh> meshResource = co_await cache->loadAsync<Mesh>(path, lifetime.GetToken());
+        if (!meshResource)
+            co_return;
+
+        addMesh(meshResource->GetID());
+    }
+
+    Entity Scene::addMesh(UUID meshID)
     {
         std::shared_ptr<Mesh> meshResource = cache->GetByUUID<Mesh>(meshID);
         int subMeshCount = meshResource->getSubMeshCount();
         UUID defaultMaterialID = cache->GetDefaultMaterial()->GetID();
 
-        Entity& entity = CreateEntity(meshResource->getName());
-        auto& meshFilterComp = entity.AddComponent<MeshFilterComponent>(meshResource->GetID());
+        Entity entity = CreateEntity(meshResource->getName());
+        auto& meshFilterComp = entity.AddComponent<MeshFilterComponent>(meshResource->GetID(), meshResource->GetHandle<Mesh>());
         meshFilterComp.names.resize(subMeshCount);
+        meshFilterComp.materials.resize(subMeshCount, UUIDFactory::getInvalidUUID());
 
         for (int i = 0; i < subMeshCount; i++)
         {
@@ -104,9 +128,9 @@ namespace Iaonnis
         return entity;
     }
 
-    Entity& Iaonnis::Scene::addDirectionalLight(glm::vec3 direction )
+    Entity Iaonnis::Scene::addDirectionalLight(glm::vec3 direction )
     {
-        Entity& entity = CreateEntity("Directional Light");
+        Entity entity = CreateEntity("Directional Light");
         auto& lightComp = entity.AddComponent<LightComponent>();
         lightComp.color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
         lightComp.type = LightType::Directional;
@@ -115,9 +139,9 @@ namespace Iaonnis
         return entity;
     }
 
-    Entity& Scene::addSpotLight()
+    Entity Scene::addSpotLight()
     {
-        Entity& entity = CreateEntity("Spot Light");
+        Entity entity = CreateEntity("Spot Light");
         auto& lightComp = entity.AddComponent<LightComponent>();
         lightComp.color = glm::vec4(0.8f, 0.6f, 0.6f, 1.0f);
         lightComp.type = LightType::Spot;
@@ -130,9 +154,9 @@ namespace Iaonnis
         return entity;
     }
 
-    Entity& Scene::AddPointLight()
+    Entity Scene::AddPointLight()
     {
-        Entity& entity = CreateEntity("Point Light");
+        Entity entity = CreateEntity("Point Light");
         auto& lightComp = entity.AddComponent<LightComponent>();
         lightComp.color = glm::vec4(0.8f, 0.6f, 0.6f, 1.0f);
         lightComp.type = LightType::Point;
@@ -141,48 +165,55 @@ namespace Iaonnis
         return entity;
     }
 
-    Entity& Scene::AddCamera()
+    Entity Scene::AddCamera()
     {
-        Entity& entity = CreateEntity("Camera");
+        Entity entity = CreateEntity("Camera");
         auto& cameraComp = entity.GetComponent<CameraComponent>();
         cameraComp;
 
         return entity;
     }
 
-    Entity& Scene::AddCube(const std::string& name)
+    Entity Scene::AddCube(const std::string& name)
     {
         auto meshResource = cache->GetByName<Mesh>("Cube");
         UUID defaultMtlID = cache->GetDefaultMaterial()->GetID();
 
-        Entity& entity = CreateEntity(name);
-        auto& meshFilterComp = entity.AddComponent<MeshFilterComponent>(meshResource->GetID());
+        Entity entity = CreateEntity(name);
+        auto& meshFilterComp = entity.AddComponent<MeshFilterComponent>(meshResource->GetID(), meshResource->GetHandle<Mesh>());
 
         meshFilterComp.names.resize(1);
+        meshFilterComp.materials.resize(1, UUIDFactory::getInvalidUUID());
 
         AssignMaterial(entity.GetUUID(), defaultMtlID, 0);
-        meshFilterComp.names[0] = "Sub" + meshResource->getSubMesh(0)->name;
+        meshFilterComp.names[0] = StringId("Sub" + meshResource->getSubMesh(0)->name.str());
 
         return entity;
     }
 
-    Entity& Scene::AddPlane(const std::string& name)
+    Entity Scene::AddPlane(const std::string& name)
     {
         auto meshResource = cache->GetByName<Mesh>("Plane");
         UUID defaultMtlID = cache->GetDefaultMaterial()->GetID();;
 
-        Entity& entity = CreateEntity(name);
-        auto& meshFilterComp = entity.AddComponent<MeshFilterComponent>(cache->GetByName<Mesh>("Plane")->GetID());
+        Entity entity = CreateEntity(name);
+        auto& meshFilterComp = entity.AddComponent<MeshFilterComponent>(meshResource->GetID(), meshResource->GetHandle<Mesh>());
         meshFilterComp.names.resize(1);
+        meshFilterComp.materials.resize(1, UUIDFactory::getInvalidUUID());
 
         AssignMaterial(entity.GetUUID(), defaultMtlID, 0);
-        meshFilterComp.names[0] = "Sub" + meshResource->getSubMesh(0)->name;
+        meshFilterComp.names[0] = StringId("Sub" + meshResource->getSubMesh(0)->name.str());
         return entity;
     }
 
     void Scene::AssignMaterial(UUID entityID, UUID mtlID, int subMeshIndex)
     {
-        auto& entt = GetEntity(entityID);
+        Entity entt = GetEntity(entityID);
+        if (!entt.IsValid())
+        {
+            IAONNIS_LOG_ERROR("Invalid entity id. (UUID = %s)", UUIDFactory::uuidToString(entityID).c_str());
+            return;
+        }
         UUID previousMTLID = entt.GetSubMeshMaterial(subMeshIndex);
         cache->UnUse<Material>(previousMTLID);
         entt.AssignMaterial(mtlID, subMeshIndex);
@@ -191,7 +222,12 @@ namespace Iaonnis
 
     void Scene::ResetMaterial(UUID entityID, int subMeshIndex)
     {
-        auto& entt = GetEntity(entityID);
+        Entity entt = GetEntity(entityID);
+        if (!entt.IsValid())
+        {
+            IAONNIS_LOG_ERROR("Invalid entity id. (UUID = %s)", UUIDFactory::uuidToString(entityID).c_str());
+            return;
+        }
 
         UUID previousMTLID = entt.GetSubMeshMaterial(subMeshIndex);
         cache->UnUse<Material>(previousMTLID);
@@ -201,7 +237,12 @@ namespace Iaonnis
 
     void Scene::AssigGlobalMaterial(UUID entityID, UUID mtlID)
     {
-        auto& entt = GetEntity(entityID);
+        Entity entt = GetEntity(entityID);
+        if (!entt.IsValid())
+        {
+            IAONNIS_LOG_ERROR("Invalid entity id. (UUID = %s)", UUIDFactory::uuidToString(entityID).c_str());
+            return;
+        }
         
         auto materials = entt.GetMaterialsInUse();
         for (auto& mtl : materials)
@@ -215,7 +256,12 @@ namespace Iaonnis
 
     void Scene::ResetAllMaterial(UUID entityID)
     {
-        auto& entt = GetEntity(entityID);
+        Entity entt = GetEntity(entityID);
+        if (!entt.IsValid())
+        {
+            IAONNIS_LOG_ERROR("Invalid entity id. (UUID = %s)", UUIDFactory::uuidToString(entityID).c_str());
+            return;
+        }
 
         auto materials = entt.GetMaterialsInUse();
         for (auto& mtl : materials)
@@ -230,38 +276,37 @@ namespace Iaonnis
 
     void Scene::RemoveEntity(Entity entity)
     {
-        removeFromVector<Entity>(entities, entity);
+        entityIndex.erase(entity.GetUUID());
         registry.destroy(entity.GetBaseEntity());
 
         OnEntityRegisteryModified();
         OnMaterialModified();
     }
 
-    Entity& Scene::GetEntity(UUID id)
+    Entity Scene::GetEntity(UUID id)
     {
-        for (auto& entt : entities)
-        {
-            if (entt.GetUUID() == id)
-                return entt;
-        }
+        auto it = entityIndex.find(id);
+        if (it == entityIndex.end())
+            return Entity();
+
+        return Entity(it->second, this);
     }
 
-    void Scene::OnViewFrameResize(Event& event)
+    void Scene::OnViewFrameResize(FrameResizeEvent& frameResizeEvent)
     {
-        FrameResizeEvent* frameResizeEvent = (FrameResizeEvent*)&event;
-        camera->setAspectRatio(frameResizeEvent->frameSizeX, frameResizeEvent->frameSizeY);
+        camera->setAspectRatio(frameResizeEvent.frameSizeX, frameResizeEvent.frameSizeY);
     }
 
     void Scene::Save(filespace::filepath path)
     {
         fkyaml::node node{
             {"Name",name},
-            {"No. Entt",entities.size()},
+            {"No. Entt",GetEntityCount()},
             {"Resource",fkyaml::node::sequence()}
         };
 
         std::vector<fkyaml::node> enttNodes;
-        for (auto entt : entities)
+        EachEntity([&](Entity entt)
         {
             auto idString = UUIDFactory::uuidToString(entt.GetUUID());
             auto tag = entt.GetTag();
@@ -290,18 +335,15 @@ namespace Iaonnis
                 };
 
                 fkyaml::ordered_map<std::string, std::vector<int>> materialMapTemp;
-                for (auto& [mtl, dependants] : meshFilter.materialIDMap)
-                {
-                    for (auto dep : dependants)
-                        materialMapTemp[UUIDFactory::uuidToString(mtl)].push_back(dep);
-                }
+                for (auto& [mtl, dependants] : entt.GetMaterialUsers())
+                    materialMapTemp[UUIDFactory::uuidToString(mtl)] = dependants;
                 meshFilterNode["Material"] = materialMapTemp;
 
                 std::vector<std::string> namesNode(entt.GetSubMeshCount());
                 int i = 0;
                 for (auto& name : meshFilter.names)
                 {
-                    namesNode[i++] = name;
+                    namesNode[i++] = name.str();
                 }
                 meshFilterNode["Names"] = namesNode;
 
@@ -324,26 +366,26 @@ namespace Iaonnis
             }
             
             enttNodes.emplace_back(temp);
-        }
+        });
         node["Entities"] = enttNodes;
 
         std::vector<fkyaml::node> resourceNodes;
-        for (auto& resource : cache->getByType<ImageTexture>(ResourceType::ImageTexture))
+        for (auto& resource : cache->getByType<ImageTexture>())
         {
             fkyaml::node resourceNode = {
-                {"Path",resource->getPath().string()},
-                {"Type",(int)resource->getType()},
-                {"UUID",UUIDFactory::uuidToString(resource->GetID())}
+                {"Path",resource.getPath().string()},
+                {"Type",(int)resource.getType()},
+                {"UUID",UUIDFactory::uuidToString(resource.GetID())}
             };
             resourceNodes.push_back(resourceNode);
         }
 
-        for (auto& resource : cache->getByType<Mesh>(ResourceType::Mesh))
+        for (auto& resource : cache->getByType<Mesh>())
         {
             fkyaml::node resourceNode = {
-                {"Path",resource->getPath().string()},
-                {"Type",(int)resource->getType()},
-                {"UUID",UUIDFactory::uuidToString(resource->GetID())}
+                {"Path",resource.getPath().string()},
+                {"Type",(int)resource.getType()},
+                {"UUID",UUIDFactory::uuidToString(resource.GetID())}
             };
             resourceNodes.push_back(resourceNode);
         }
@@ -17,20 +17,23 @@ namespace Iaonnis
 
 			void OnUpdate(float dt);
 
-			Entity& CreateEntity(const std::string& name);
-			Entity& CreateCamera(const std::string& name);
+			Entity CreateEntity(const std::string& name);
+			Entity CreateCamera(const std::string& name);
 
-			Entity& addMesh(filespace::filepath path, const std::string& name);
-			Entity& addMesh(UUID meshID);
+			Entity addMesh(filespace::filepath path, const std::string& name);
+			Entity addMesh(UUID meshID);
 
-			Entity& addDirectionalLight(glm::vec3 direction = glm::vec3(1.0f, 0.0f, 0.0f));
-			Entity& addSpotLight();
-			Entity& AddPointLight();
+			/// @brief Loads the mesh in the background and adds it once it is ready. Cancelled if the scene is destroyed first.
+			Task<void> addMeshAsync(filespace::filepath path);
 
-			Entity& AddCamera();
+			Entity addDirectionalLight(glm::vec3 direction = glm::vec3(1.0f, 0.0f, 0.0f));
+			Entity addSpotLight();
+			Entity AddPointLight();
 
-			Entity& AddCube(const std::string& name);
-			Entity& AddPlane(const std::string& name);
+			Entity AddCamera();
+
+			Entity AddCube(const std::string& name);
+			Entity AddPlane(const std::string& name);
 
 			void AssignMaterial(UUID entityID, UUID mtlID, int subMeshIndex);
 			void AssigGlobalMaterial(UUID entityID, UUID mtlID);
@@ -40,10 +43,13 @@ namespace Iaonnis
 
 			void RemoveEntity(Entity entity);
 
+			/// @brief The result lives in frame memory, do not keep it past the current frame.
+			/// Reads the registry through its const interface, so read-only frame stages may call it side by side.
 			template<typename... T>
-			std::vector<Entity> getEntitiesWith() {
-				std::vector<Entity> ents;
-				auto view = registry.view<T...>();
+			FrameVector<Entity> getEntitiesWith() {
+				FrameVector<Entity> ents;
+				auto view = std::as_const(registry).view<T...>();
+				ents.reserve(std::distance(view.begin(), view.end()));
 
 				for (auto entity : view) {
 					ents.emplace_back(entity, this); 
@@ -52,12 +58,14 @@ namespace Iaonnis
 				return ents;
 			}
 			
-			std::vector<Entity>& GetEntities()
-			{
-				return entities;
-			}
+			/// @brief Calls function(Entity) for every entity, straight off the registry. Defined in Entity.h.
+			template<typename Function>
+			void EachEntity(Function&& function);
+
+			size_t GetEntityCount() { return registry.storage<IDComponent>().size(); }
 
-			Entity& GetEntity(UUID id);
+			/// @brief O(1) through the UUID index. Returns an invalid Entity if no entity has the id.
+			Entity GetEntity(UUID id);
 
 			std::shared_ptr<ResourceCache> getCache() { return cache; }
 			const std::string& getName()const { return name; }
@@ -76,12 +84,13 @@ namespace Iaonnis
 			std::shared_ptr<Environment> GetEnvironment() { return environment; }
 
 		private:
-			void OnViewFrameResize(Event& event);
+			void OnViewFrameResize(FrameResizeEvent& event);
 		private:
 			friend class Entity;
 			entt::registry registry;
 
-			std::vector<Entity> entities;
+			//Kept in sync by CreateEntity() and RemoveEntity().
+			std::unordered_map<UUID, entt::entity> entityIndex;
 			std::shared_ptr<ResourceCache> cache;
 
 			std::string name;
@@ -94,5 +103,10 @@ namespace Iaonnis
 			std::shared_ptr<Environment> environment;
 
 			std::vector<std::unique_ptr<System>> systems;
+
+			EventListenerHandle resizeListener;
+
+			//Cancels pending async loads when the scene goes away.
+			CancellationSource lifetime;
 	};
 }
\ No newline at end of file
@@ -38,18 +38,26 @@ namespace Iaonnis
 
 		virtual void OnUpdate(float dt) override
 		{
-			for (auto entt : registery->view<TransformComponent>())
-			{
-				auto& transform = registery->get<TransformComponent>(entt);
+			auto& transforms = registery->storage<TransformComponent>();
 
-				transform.model = glm::translate(glm::mat4(1.0f), transform.position);
+			JobHandle job = JobSystem::ParallelFor((uint32_t)transforms.size(), 256, [&transforms](uint32_t begin, uint32_t end)
+				{
+					auto it = transforms.begin() + begin;
+					for (uint32_t i = begin; i < end; i++, ++it)
+					{
+						auto& transform = *it;
 
-				transform.model = glm::rotate(transform.model, glm::radians(transform.rotation.x), glm::vec3(1, 0, 0)); 
-				transform.model = glm::rotate(transform.model, glm::radians(transform.rotation.y), glm::vec3(0, 1, 0)); 
-				transform.model = glm::rotate(transform.model, glm::radians(transform.rotation.z), glm::vec3(0, 0, 1));
+						transform.model = glm::translate(glm::mat4(1.0f), transform.position);
 
-				transform.model = glm::scale(transform.model, transform.scale);
-			}
+						transform.model = glm::rotate(transform.model, glm::radians(transform.rotation.x), glm::vec3(1, 0, 0)); 
+						transform.model = glm::rotate(transform.model, glm::radians(transform.rotation.y), glm::vec3(0, 1, 0)); 
+						transform.model = glm::rotate(transform.model, glm::radians(transform.rotation.z), glm::vec3(0, 0, 1));
+
+						transform.model = glm::scale(transform.model, transform.scale);
+					}
+				}, JobType::Scene);
+
+			JobSystem::Wait(job);
 		}
 
 	private:
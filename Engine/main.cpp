@@ -6,7 +6,7 @@ int main()
 	Iaonnis::Application application;
 	application.InitializeApplication();
 	application.OnUpdate();
-	application.Shutdown();
+	return application.Shutdown();
 }
 
 